@@ -3,3 +3,5 @@
 # pyre-strict
 
 ENABLE_EXPERIMENTAL: bool = False
+
+from ft_utils._sort import parallel_sort as parallel_sort  # noqa: E402
@@ -5,6 +5,7 @@
 from typing import (
     Dict,
     Generic,
+    Iterable,
     Iterator,
     List,
     Mapping,
@@ -16,17 +17,23 @@ from typing import (
     Union,
 )
 
+def register_reference_batch(sequence: Iterable[object]) -> None: ...
+
 K = TypeVar("K")
 V = TypeVar("V")
 T = TypeVar("T")
 
 class ConcurrentDict(Generic[K, V]):
     @overload
-    def __init__(self, initial_capacity: Optional[int] = ...) -> None: ...
+    def __init__(
+        self, initial_capacity: Optional[int] = ..., *, growable: bool = ...
+    ) -> None: ...
     @overload
-    def __init__(self, *, dictionary: Dict[K, V]) -> None: ...
+    def __init__(self, *, dictionary: Dict[K, V], growable: bool = ...) -> None: ...
     @overload
-    def __init__(self, initial_capacity: int, dictionary: Dict[K, V]) -> None: ...
+    def __init__(
+        self, initial_capacity: int, dictionary: Dict[K, V], growable: bool = ...
+    ) -> None: ...
     def __contains__(self, key: K) -> bool: ...
     def __setitem__(self, key: K, value: V) -> None: ...
     def __getitem__(self, key: K) -> V: ...
@@ -54,6 +61,17 @@ class ConcurrentDict(Generic[K, V]):
         other: Union[Mapping[K, V], "ConcurrentDict[K, V]", None] = ...,
         **kwargs: V,
     ) -> None: ...
+    def update_batch(self, pairs: Sequence[Tuple[K, V]]) -> None: ...
+    @overload
+    def get_many(self, keys: Sequence[K]) -> List[V | None]: ...
+    @overload
+    def get_many(self, keys: Sequence[K], default: T) -> List[V | T]: ...
+    @overload
+    def pop_many(self, keys: Sequence[K]) -> List[V]: ...
+    @overload
+    def pop_many(self, keys: Sequence[K], default: T) -> List[V | T]: ...
+    def iter_snapshot(self) -> Iterator[K]: ...
+    def items_snapshot(self) -> Iterator[Tuple[K, V]]: ...
     def keys(self) -> List[K]: ...
     def values(self) -> List[V]: ...
     def items(self) -> List[Tuple[K, V]]: ...
@@ -70,6 +88,10 @@ class ConcurrentDeque(Generic[E]):
     def extendleft(self, iterable: Sequence[E]) -> None: ...
     def pop(self) -> E: ...
     def popleft(self) -> E: ...
+    @overload
+    def pop_steal(self) -> E | None: ...
+    @overload
+    def pop_steal(self, default: T) -> E | T: ...
     def remove(self, value: E) -> None: ...
     def rotate(self, n: int = 1) -> None: ...
     def __getitem__(self, index: int) -> E: ...
@@ -84,6 +106,80 @@ class ConcurrentDeque(Generic[E]):
     def __ge__(self, other: object) -> bool: ...
     def __repr__(self) -> str: ...
 
+class ConcurrentQueue(Generic[E]):
+    def __init__(self) -> None: ...
+    def push(self, value: E) -> None: ...
+    def pop(self, timeout: Optional[float] = None) -> E: ...
+    def shutdown(self, immediate: bool = False) -> None: ...
+    def size(self) -> int: ...
+    def empty(self) -> bool: ...
+
+class ConcurrentSet(Generic[E]):
+    def __init__(
+        self,
+        iterable: Optional[Iterable[E]] = None,
+        initial_capacity: int = 0,
+        growable: bool = False,
+    ) -> None: ...
+    def add(self, element: E) -> None: ...
+    def discard(self, element: E) -> None: ...
+    def remove(self, element: E) -> None: ...
+    def update(self, iterable: Iterable[E]) -> None: ...
+    def union(self, iterable: Iterable[E]) -> "ConcurrentSet[E]": ...
+    def intersection(self, iterable: Iterable[E]) -> "ConcurrentSet[E]": ...
+    def as_set(self) -> set[E]: ...
+    def clear(self) -> None: ...
+    def __contains__(self, element: object) -> bool: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[E]: ...
+    def __eq__(self, other: object) -> bool: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+
+class ConcurrentRingQueue(Generic[E]):
+    def __init__(self, capacity: int = 1024) -> None: ...
+    def push(self, value: E, timeout: Optional[float] = None) -> None: ...
+    def pop(self, timeout: Optional[float] = None) -> E: ...
+    def shutdown(self, immediate: bool = False) -> None: ...
+    def size(self) -> int: ...
+    def capacity(self) -> int: ...
+    def empty(self) -> bool: ...
+    def full(self) -> bool: ...
+
+FlatKey = Union[bytes, str, int]
+FlatValue = Union[bytes, str, int, float]
+
+class SharedMemoryDict:
+    def __init__(
+        self,
+        name: str,
+        create: bool = False,
+        capacity: int = 0,
+        data_size: int = 0,
+        writable: bool = ...,
+    ) -> None: ...
+    def __getitem__(self, key: FlatKey) -> FlatValue: ...
+    def __setitem__(self, key: FlatKey, value: FlatValue) -> None: ...
+    def __delitem__(self, key: FlatKey) -> None: ...
+    def __contains__(self, key: FlatKey) -> bool: ...
+    def __len__(self) -> int: ...
+    def __repr__(self) -> str: ...
+    @overload
+    def get(self, key: FlatKey) -> Optional[FlatValue]: ...
+    @overload
+    def get(self, key: FlatKey, default: T) -> Union[FlatValue, T]: ...
+    def keys(self) -> List[FlatKey]: ...
+    def as_dict(self) -> Dict[FlatKey, FlatValue]: ...
+    def close(self) -> None: ...
+    def unlink(self) -> None: ...
+
+class AtomicFlag:
+    def __init__(self, value: bool) -> None: ...
+    def set(self, value: bool) -> None: ...
+    def wait_until_set(self, timeout: Optional[float] = None) -> bool: ...
+    def wait_until_clear(self, timeout: Optional[float] = None) -> bool: ...
+    def __bool__(self) -> bool: ...
+
 class AtomicInt64:
     def __init__(self, value: int = ...) -> None: ...
     def set(self, value: int) -> None: ...
@@ -118,9 +214,45 @@ class AtomicInt64:
     def __gt__(self, other: object) -> bool: ...
     def __ge__(self, other: object) -> bool: ...
 
+class AtomicInt64Array:
+    def __init__(self, size: int, striped: bool = False) -> None: ...
+    def incr(self, index: int) -> None: ...
+    def decr(self, index: int) -> None: ...
+    def add(self, index: int, value: int) -> None: ...
+    def get(self, index: int) -> int: ...
+    def set(self, index: int, value: int) -> None: ...
+    def to_list(self) -> List[int]: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> int: ...
+
 class AtomicReference(Generic[V]):
     def __init__(self, value: Optional[V] = None) -> None: ...
     def set(self, value: V) -> None: ...
     def get(self) -> Optional[V]: ...
     def exchange(self, value: V) -> Optional[V]: ...
     def compare_exchange(self, expected: V, value: V) -> bool: ...
+
+class AtomicReferenceArray(Generic[V]):
+    def __init__(self, size: int, initial: Optional[V] = None) -> None: ...
+    def get(self, index: int) -> Optional[V]: ...
+    def set(self, index: int, value: V) -> None: ...
+    def exchange(self, index: int, value: V) -> Optional[V]: ...
+    def compare_exchange(self, index: int, expected: V, value: V) -> bool: ...
+    def to_list(self) -> List[Optional[V]]: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> Optional[V]: ...
+    def __setitem__(self, index: int, value: V) -> None: ...
+
+class AtomicStampedReference(Generic[V]):
+    def __init__(self, value: Optional[V] = None, stamp: int = 0) -> None: ...
+    def set(self, value: V, stamp: int) -> None: ...
+    def get(self) -> Tuple[Optional[V], int]: ...
+    def get_reference(self) -> Optional[V]: ...
+    def get_stamp(self) -> int: ...
+    def compare_exchange(
+        self,
+        expected: Optional[V],
+        value: V,
+        expected_stamp: int,
+        new_stamp: Optional[int] = None,
+    ) -> bool: ...
@@ -0,0 +1,9 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+from typing import List, TypeVar
+
+T = TypeVar("T")
+
+def parallel_sort(target: List[T], threads: int = 0) -> None: ...
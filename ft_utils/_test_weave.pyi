@@ -33,3 +33,15 @@ def get_destructor_called_1() -> int:
 def get_destructor_called_2() -> int:
     """Get the value of destructor_called_2"""
     ...
+
+def arena_exercise() -> None:
+    """Allocate assorted sizes from the thread's arena."""
+    ...
+
+def arena_reset_reuses() -> bool:
+    """Check wvls_arena_reset makes arena memory reusable."""
+    ...
+
+def arena_large() -> None:
+    """Allocate more than a chunk from the thread's arena."""
+    ...
@@ -0,0 +1,11 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+from collections.abc import Callable
+from typing import Union
+
+def bench(
+    operation: Callable[[], object], iterations: int, batch: int = 1
+) -> dict[str, Union[int, float]]: ...
+def ns_clock() -> int: ...
@@ -98,6 +98,15 @@ class ReferenceBenchmarkProvider(BenchmarkProvider):
             else:
                 _ = ref.get()
 
+    def latency_atomic_get(self) -> None:
+        _ = self._atomic_ref.get()
+
+    def latency_atomic_set(self) -> None:
+        self._atomic_ref.set(1)
+
+    def latency_locked_get(self) -> None:
+        _ = self._locked_ref.get()
+
 
 def invoke_main() -> None:
     execute_benchmarks(ReferenceBenchmarkProvider)
@@ -0,0 +1,258 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+"""Suite runner for the *_bench benchmarks.
+
+Discovers every ft_utils.*_bench module, runs each BenchmarkProvider it
+defines across a matrix of thread counts and emits structured JSON
+(ops/sec, p50/p99 run latencies and per-thread scaling efficiency) so CI
+can track results across releases. A stored baseline JSON can be compared
+against with a configurable regression threshold:
+
+    python -m ft_utils.benchmark_suite --threads 1,4,16 --json results.json
+    python -m ft_utils.benchmark_suite --baseline results.json --threshold 0.2
+"""
+
+import argparse
+import concurrent.futures
+import importlib
+import json
+import pkgutil
+import platform
+import statistics
+import sys
+import threading
+import time
+from collections.abc import Callable
+from types import ModuleType
+from typing import Union
+
+import ft_utils
+
+from ft_utils.benchmark_utils import BenchmarkProvider
+
+SummaryType = dict[str, Union[int, float]]
+ResultsType = dict[str, dict[str, dict[str, SummaryType]]]
+SuiteType = dict[str, Union[dict[str, Union[str, int]], ResultsType]]
+
+
+def discover_bench_modules() -> list[str]:
+    """Return the importable names of all *_bench modules in ft_utils."""
+    return sorted(
+        f"ft_utils.{module_info.name}"
+        for module_info in pkgutil.iter_modules(ft_utils.__path__)
+        if module_info.name.endswith("_bench")
+    )
+
+
+def find_providers(module: ModuleType) -> list[type[BenchmarkProvider]]:
+    """Return the BenchmarkProvider subclasses defined by a bench module."""
+    return [
+        value
+        for value in vars(module).values()
+        if isinstance(value, type)
+        and issubclass(value, BenchmarkProvider)
+        and value is not BenchmarkProvider
+        and value.__module__ == module.__name__
+    ]
+
+
+def _run_operation(
+    operation_func: Callable[[], None], threads: int, repeats: int
+) -> list[float]:
+    """Time repeats runs of the operation on each of threads threads."""
+    barrier = threading.Barrier(threads)
+
+    def work() -> list[float]:
+        barrier.wait()
+        run_times: list[float] = []
+        for _ in range(repeats):
+            start = time.monotonic()
+            operation_func()
+            run_times.append(time.monotonic() - start)
+        return run_times
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=threads) as executor:
+        futures = [executor.submit(work) for _ in range(threads)]
+        run_times = []
+        for future in concurrent.futures.as_completed(futures):
+            run_times.extend(future.result())
+    return run_times
+
+
+def _percentile(sorted_times: list[float], fraction: float) -> float:
+    index = min(int(len(sorted_times) * fraction), len(sorted_times) - 1)
+    return sorted_times[index]
+
+
+def summarize(run_times: list[float], operations: int, threads: int) -> SummaryType:
+    """Reduce raw per-run times to the stats tracked by the suite."""
+    ordered = sorted(run_times)
+    mean = statistics.mean(ordered)
+    return {
+        "runs": len(ordered),
+        "mean": mean,
+        "p50": _percentile(ordered, 0.5),
+        "p99": _percentile(ordered, 0.99),
+        "ops_per_sec": threads * operations / mean if mean > 0 else 0.0,
+    }
+
+
+def run_suite(
+    module_names: list[str],
+    operations: int,
+    thread_counts: list[int],
+    repeats: int,
+    name_filter: str = "",
+) -> SuiteType:
+    """Run every provider of every module across the thread matrix."""
+    results: ResultsType = {}
+    for module_name in module_names:
+        try:
+            module = importlib.import_module(module_name)
+        except Exception as error:  # noqa: B902
+            # Some bench modules need newer Pythons; skip rather than fail
+            # the whole suite.
+            print(f"skipping {module_name}: {error}", file=sys.stderr)
+            continue
+        for provider_class in find_providers(module):
+            provider = provider_class(operations)
+            operation_methods = [
+                (method_name[10:], getattr(provider, method_name))
+                for method_name in dir(provider)
+                if callable(getattr(provider, method_name))
+                and method_name.startswith("benchmark_")
+            ]
+            for operation_name, operation_func in operation_methods:
+                full_name = f"{module_name.rsplit('.', 1)[-1]}.{operation_name}"
+                if name_filter and name_filter not in full_name:
+                    continue
+                by_threads: dict[str, SummaryType] = {}
+                for threads in thread_counts:
+                    if hasattr(provider, "set_up"):
+                        provider.set_up()  # pyre-ignore[16]
+                    run_times = _run_operation(operation_func, threads, repeats)
+                    by_threads[str(threads)] = summarize(
+                        run_times, operations, threads
+                    )
+                _add_scaling_efficiency(by_threads, thread_counts)
+                results.setdefault(module_name, {})[operation_name] = by_threads
+    return {
+        "metadata": {
+            "python": platform.python_version(),
+            "platform": platform.platform(),
+            "timestamp": int(time.time()),
+            "operations": operations,
+            "repeats": repeats,
+        },
+        "results": results,
+    }
+
+
+def _add_scaling_efficiency(
+    by_threads: dict[str, SummaryType], thread_counts: list[int]
+) -> None:
+    """Annotate each thread count with throughput relative to perfect scaling
+    from the smallest thread count in the matrix."""
+    base_threads = min(thread_counts)
+    base = by_threads[str(base_threads)]["ops_per_sec"]
+    if base <= 0:
+        return
+    for threads in thread_counts:
+        summary = by_threads[str(threads)]
+        ideal = base * threads / base_threads
+        summary["scaling_efficiency"] = summary["ops_per_sec"] / ideal
+
+
+def compare_to_baseline(
+    suite: SuiteType, baseline: SuiteType, threshold: float
+) -> list[str]:
+    """Return a description of every operation whose throughput fell more
+    than threshold (as a fraction) below the baseline."""
+    regressions: list[str] = []
+    results = suite["results"]
+    baseline_results = baseline.get("results", {})
+    assert isinstance(results, dict)
+    assert isinstance(baseline_results, dict)
+    for module_name, operations in results.items():
+        for operation_name, by_threads in operations.items():
+            for threads, summary in by_threads.items():
+                try:
+                    before = baseline_results[module_name][operation_name][threads][
+                        "ops_per_sec"
+                    ]
+                except KeyError:
+                    continue
+                now = summary["ops_per_sec"]
+                if before > 0 and now < before * (1.0 - threshold):
+                    regressions.append(
+                        f"{module_name}.{operation_name} @{threads} threads: "
+                        f"{now:.0f} ops/s vs baseline {before:.0f} ops/s "
+                        f"({(1.0 - now / before) * 100.0:.1f}% slower)"
+                    )
+    return regressions
+
+
+def invoke_main() -> None:
+    parser = argparse.ArgumentParser(description="ft_utils benchmark suite runner.")
+    parser.add_argument(
+        "--operations", type=int, default=1000, help="Operations per run."
+    )
+    parser.add_argument(
+        "--threads",
+        type=str,
+        default="1,4,16",
+        help="Comma separated thread counts to run each benchmark at.",
+    )
+    parser.add_argument(
+        "--repeats", type=int, default=5, help="Timed runs per thread."
+    )
+    parser.add_argument(
+        "--filter",
+        type=str,
+        default="",
+        help="Only run benchmarks whose module.operation name contains this.",
+    )
+    parser.add_argument(
+        "--json", type=str, default="", help="Write results JSON to this file."
+    )
+    parser.add_argument(
+        "--baseline", type=str, default="", help="Compare against this baseline JSON."
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="Fractional ops/sec drop below baseline counted as a regression.",
+    )
+    args = parser.parse_args()
+
+    thread_counts = sorted({int(part) for part in args.threads.split(",")})
+    suite = run_suite(
+        discover_bench_modules(),
+        args.operations,
+        thread_counts,
+        args.repeats,
+        args.filter,
+    )
+
+    output = json.dumps(suite, indent=2, sort_keys=True)
+    if args.json:
+        with open(args.json, "w") as json_file:
+            json_file.write(output + "\n")
+    else:
+        print(output)
+
+    if args.baseline:
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+        regressions = compare_to_baseline(suite, baseline, args.threshold)
+        for regression in regressions:
+            print(f"REGRESSION: {regression}", file=sys.stderr)
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    invoke_main()
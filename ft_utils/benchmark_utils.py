@@ -5,7 +5,6 @@
 import argparse
 import concurrent.futures
 import os
-import random
 import sys
 import threading
 import time
@@ -13,39 +12,26 @@ import traceback
 from collections.abc import Callable, Sequence
 from typing import TypeVar
 
-from ft_utils.local import BatchExecutor
-
-
-_BATCH_RAND = BatchExecutor(lambda: random.getrandbits(32), 1024)
+from ft_utils import _timing
+from ft_utils import random as ft_random
 
 
 # Use these for random manipulations as they are much more performant
-# in FTPython under contention than the random.* alternatives.
+# in FTPython under contention than the random.* alternatives. They are thin
+# shims over the native thread-local generators in ft_utils.random kept for
+# their more forgiving signatures (ft_randint accepts its bounds in either
+# order).
 def ft_randint(a: int, b: int) -> int:
     if a > b:
         a, b = b, a
-
-    range_size = b - a + 1
-    range_bits = range_size.bit_length()
-
-    accumulated_random = 0
-    bits_collected = 0
-
-    while bits_collected < range_bits:
-        accumulated_random = (accumulated_random << 32) | _BATCH_RAND.load()
-        bits_collected += 32
-
-    result = accumulated_random % range_size
-    return a + result
+    return ft_random.randint(a, b)
 
 
 T = TypeVar("T")
 
 
 def ft_randchoice(seq: Sequence[T]) -> T:
-    if not seq:
-        raise IndexError("Cannot choose from an empty sequence")
-    return seq[ft_randint(0, len(seq) - 1)]
+    return ft_random.choice(seq)
 
 
 class BenchmarkProvider:
@@ -87,6 +73,23 @@ def benchmark_operation(operation_func: Callable[[], None]) -> float:
     return end_time - start_time
 
 
+def benchmark_operation_distribution(
+    operation_func: Callable[[], object],
+    iterations: int = 100000,
+    batch: int = 100,
+) -> dict[str, int | float]:
+    """
+    Measures the per-operation latency distribution of a single operation.
+
+    Unlike benchmark_operation, the timed loop runs in C so the numbers are
+    not dominated by Python call overhead; use this with a callable that
+    performs one operation (e.g. an AtomicInt64.incr bound method) rather
+    than a loop. Returns nanosecond stats including p50/p99 from a native
+    histogram; see ft_utils._timing.bench.
+    """
+    return _timing.bench(operation_func, iterations, batch)
+
+
 def worker(
     operation_func: Callable[[], None],
     barrier: threading.Barrier,
@@ -151,3 +154,23 @@ def execute_benchmarks(
                 print(
                     f"    {operation_name:<32} Max: {max_time:.6f} Mean: {mean_time:.6f} Min: {min_time:.6f}"
                 )
+
+    # Providers may also define latency_* methods, each performing a single
+    # operation per call; these are measured in C for true per-op latency
+    # distributions rather than wall-clock averages over whole runs.
+    latency_methods = [
+        (method_name[8:], getattr(provider_instance, method_name))
+        for method_name in dir(provider_instance)
+        if callable(getattr(provider_instance, method_name))
+        and method_name.startswith("latency_")
+    ]
+    for operation_name, operation_func in latency_methods:
+        if hasattr(provider_instance, "set_up"):
+            provider_instance.set_up()  # pyre-ignore[16]
+        stats = benchmark_operation_distribution(
+            operation_func, iterations=num_operations
+        )
+        print(
+            f"    {operation_name:<32} p50: {stats['p50_ns']}ns p99: {stats['p99_ns']}ns"
+            f" Mean: {stats['mean_ns']:.1f}ns Min: {stats['min_ns']}ns"
+        )
@@ -5,8 +5,9 @@
 import os
 import threading
 import time
-from collections.abc import Iterator
+from collections.abc import Callable, Iterable, Iterator, Sequence
 from queue import Empty, Full
+from typing import TypeVar
 
 try:
     from queue import ShutDown  # type: ignore
@@ -17,23 +18,26 @@ except ImportError:
 
 
 from ft_utils._concurrency import (
+    AtomicFlag,
     AtomicInt64,
+    AtomicInt64Array,
     AtomicReference,
+    AtomicReferenceArray,
+    AtomicStampedReference,
     ConcurrentDeque,
     ConcurrentDict,
+    ConcurrentRingQueue,
+    ConcurrentSet,
+    register_reference_batch,
+    SharedMemoryDict,
 )
 from ft_utils.local import LocalWrapper
 
+# Sentinel distinguishing "key not inserted" from an inserted None.
+_MISSING: object = object()
 
-class AtomicFlag:
-    def __init__(self, value: bool) -> None:
-        self._int64 = AtomicInt64(-1 if value else 0)
-
-    def set(self, value: bool) -> None:
-        self._int64.set(-1 if value else 0)
-
-    def __bool__(self) -> bool:
-        return bool(self._int64)
+_T = TypeVar("_T")
+_R = TypeVar("_R")
 
 
 class ConcurrentGatheringIterator:
@@ -57,7 +61,9 @@ class ConcurrentGatheringIterator:
             self._dict: ConcurrentDict[int, object] = ConcurrentDict(scaling)
         else:
             self._dict: ConcurrentDict[int, object] = ConcurrentDict()
-        self._cond = threading.Condition()
+        # Readers park on a per-key event so an insert only wakes the reader
+        # actually waiting for that key rather than notifying every waiter.
+        self._events: ConcurrentDict[int, threading.Event] = ConcurrentDict()
         # We probably don't need an atomic flag but it
         # it is safe and clear to use one here.
         self._failed = AtomicFlag(False)
@@ -74,10 +80,36 @@ class ConcurrentGatheringIterator:
             self._dict[key] = value
         except Exception:
             self._failed.set(True)
+            # Failure must wake every parked reader, not just this key's.
+            for waited_key in self._events.keys():
+                event = self._events.get(waited_key)
+                if event is not None:
+                    event.set()
             raise
+        event = self._events.get(key)
+        if event is not None:
+            event.set()
+
+    def _wait_for_key(self, key: int) -> object:
+        """
+        Park until the given key is inserted and return its value.
+
+        The reader registers its event before re-checking the dictionary and
+        the producer inserts before checking for an event, so whichever side
+        comes second sees the other's write and no wakeup can be lost.
+        """
+        event = self._events.setdefault(key, threading.Event())
+        try:
+            while True:
+                try:
+                    return self._dict[key]
+                except KeyError:
+                    if self._failed:
+                        raise RuntimeError("Iterator insertion failed") from None
+                    event.wait()
+                    event.clear()
         finally:
-            with self._cond:
-                self._cond.notify_all()
+            self._events.pop(key, None)
 
     def iterator(self, max_key: int, clear: bool = True) -> Iterator[object]:  # type: ignore
         """
@@ -94,29 +126,49 @@ class ConcurrentGatheringIterator:
         """
         key = 0
         _dict = LocalWrapper(self._dict)
-        _cond = LocalWrapper(self._cond)
-        _failed = LocalWrapper(self._failed)
         while key <= max_key:
             try:
                 value = _dict[key]
             except KeyError:
-                # We check the key in the dict then wait - which efficient but could result
-                # in the key being added before we wait. That would mean the notify would be
-                # called before the wait and so we miss it. Setting a timeout on the wait
-                # fixes this with introducing strict interlocking between producer and consumer
-                # (which is the very thing we are trying to avoid).
-                # pyrefly: ignore [bad-context-manager]
-                with _cond:
-                    while key not in _dict:
-                        self._cond.wait(0.01)
-                        if _failed:
-                            raise RuntimeError("Iterator insertion failed")
-                value = _dict[key]
+                value = self._wait_for_key(key)
             if clear:
                 del _dict[key]
             yield value
             key += 1
 
+    def next_n(self, key: int, max_key: int, clear: bool = True) -> list[object]:
+        """
+        Blocks for the value at key then drains every contiguously-available
+        value after it in one call, without parking between values.
+
+        Args:
+        key (int): The key to block for.
+        max_key (int): The maximum key value.
+        clear (bool): Delete the key/value pairs after reading.
+
+        Returns:
+        list[object]: Values for key onwards, ending at the first key not yet
+        inserted (or max_key). Empty if key is greater than max_key.
+        """
+        values: list[object] = []
+        _dict = LocalWrapper(self._dict)
+        missing = _MISSING
+        while key <= max_key:
+            if values:
+                value = _dict.get(key, missing)
+                if value is missing:
+                    break
+            else:
+                try:
+                    value = _dict[key]
+                except KeyError:
+                    value = self._wait_for_key(key)
+            if clear:
+                del _dict[key]
+            values.append(value)
+            key += 1
+        return values
+
     def iterator_local(self, max_key: int, clear: bool = True) -> Iterator[object]:  # type: ignore
         yield from (LocalWrapper(value) for value in self.iterator(max_key, clear))
 
@@ -403,19 +455,31 @@ class StdConcurrentQueue(ConcurrentQueue):
 
         self._maxsize: int = max(maxsize, 0)
         self._active_tasks = AtomicInt64(0)
+        # Cold-path conditions only; the hot paths never touch them. Putters
+        # park on _not_full under maxsize pressure and joiners park on
+        # _all_tasks_done, so neither side needs a sleep-poll loop.
+        self._not_full = threading.Condition()
+        self._put_waiters = AtomicInt64(0)
+        self._all_tasks_done = threading.Condition()
 
     def qsize(self) -> int:
         return self.size()
 
     def get(self, block: bool = True, timeout: float | None = None) -> object:  # type: ignore
         if block and timeout != 0.0:
-            return self.pop(timeout=timeout)
+            value = self.pop(timeout=timeout)
         else:
             # Use this to attempt to avoid excessive placeholder creation.
             if self.size() > 0:
-                return self.pop(timeout=0.0)
+                value = self.pop(timeout=0.0)
             else:
                 raise Empty
+        # This pop may have made room; wake a parked putter if there is one.
+        # The waiter count keeps the common uncontended get lock-free.
+        if self._maxsize and int(self._put_waiters) > 0:
+            with self._not_full:
+                self._not_full.notify()
+        return value
 
     def full(self) -> bool:
         _maxsize = self._maxsize
@@ -427,24 +491,27 @@ class StdConcurrentQueue(ConcurrentQueue):
         if block and self._maxsize and self.full():
             _flags = LocalWrapper(self._flags)
             _shutdown = self._SHUTDOWN
-            _sleep = LocalWrapper(time.sleep)
-            _now = LocalWrapper(time.monotonic)
-            start = _now()
             if timeout is not None:
-                end_time = start + timeout
+                end_time = time.monotonic() + timeout
             else:
                 end_time = None
-            pause_time = start + 0.05
-            while self.full():
-                it_time = _now()
-                if _flags & _shutdown:
-                    raise ShutDown
-                if end_time is not None and it_time > end_time:
-                    raise Full
-                if it_time < pause_time:
-                    _sleep(0)
-                else:
-                    _sleep(0.05)
+            # Park until a get makes room. The fullness check happens under
+            # the condition lock and get notifies under it too, so a pop
+            # between the check and the wait cannot be missed.
+            self._put_waiters.incr()
+            try:
+                with self._not_full:
+                    while self.full():
+                        if _flags & _shutdown:
+                            raise ShutDown
+                        if end_time is None:
+                            self._not_full.wait()
+                        else:
+                            remaining = end_time - time.monotonic()
+                            if remaining <= 0 or not self._not_full.wait(remaining):
+                                raise Full
+            finally:
+                self._put_waiters.decr()
         else:
             if self.full():
                 raise Full
@@ -460,18 +527,198 @@ class StdConcurrentQueue(ConcurrentQueue):
         return self.get(block=False)
 
     def task_done(self) -> None:
-        self._active_tasks.decr()
+        # Only the transition to zero can complete a join, so that is the
+        # only case which pays for the condition lock and wakeup.
+        if self._active_tasks.decr() == 0:
+            with self._all_tasks_done:
+                self._all_tasks_done.notify_all()
 
     def join(self) -> None:
-        _sleep = LocalWrapper(time.sleep)
-        _now = LocalWrapper(time.monotonic)
         _flags = LocalWrapper(self._flags)
         _shut_now = self._SHUT_NOW
         _active_tasks = LocalWrapper(self._active_tasks)
-        start = _now()
-        pause_time = start + 0.05
-        while _active_tasks and not (_flags & _shut_now):
-            if _now() < pause_time:
-                _sleep(0)
+        if not _active_tasks:
+            return
+        # task_done checks the count before locking and notifies under the
+        # lock, so re-checking under the lock here means the final wakeup
+        # cannot slip between the test and the wait.
+        with self._all_tasks_done:
+            while _active_tasks and not (_flags & _shut_now):
+                self._all_tasks_done.wait()
+
+    def shutdown(self, immediate: bool = False) -> None:
+        super().shutdown(immediate)
+        # Parked putters must wake to observe ShutDown, and an immediate
+        # shutdown ends any join in progress.
+        with self._not_full:
+            self._not_full.notify_all()
+        if immediate:
+            with self._all_tasks_done:
+                self._all_tasks_done.notify_all()
+
+
+def _run_chunked(
+    chunk_fn: Callable[[int, tuple[int, Sequence[object]]], None],
+    items: Sequence[object],
+    workers: int | None,
+    chunk_size: int | None,
+) -> None:
+    """
+    Shared scheduler for parallel_map and map_reduce.
+
+    The input is sliced into chunks which are dealt round-robin onto one
+    ConcurrentDeque per worker. Each worker drains its own deque and, once
+    empty, steals chunks from its peers with pop_steal, so a worker stuck
+    on slow items sheds the rest of its load instead of becoming the
+    critical path. No new work is ever added once the workers start, so a
+    worker finding every deque empty can simply exit; completion is a
+    plain thread join with no sleep-polling.
+    """
+    count = len(items)
+    if count == 0:
+        return
+    if workers is None:
+        workers = max(1, os.cpu_count() or 1)
+    if chunk_size is None:
+        # Several chunks per worker so stealing has something to grab
+        # without making per-chunk overhead dominate.
+        chunk_size = max(1, -(-count // (workers * 4)))
+    chunks = [
+        (offset, items[offset : offset + chunk_size])
+        for offset in range(0, count, chunk_size)
+    ]
+    workers = max(1, min(workers, len(chunks)))
+
+    deques: list[ConcurrentDeque] = [ConcurrentDeque() for _ in range(workers)]
+    for index, chunk in enumerate(chunks):
+        deques[index % workers].append(chunk)
+
+    failed = AtomicFlag(False)
+    errors: list[BaseException] = []
+
+    def steal(index: int) -> object:
+        for step in range(1, workers):
+            task = deques[(index + step) % workers].pop_steal(_MISSING)
+            if task is not _MISSING:
+                return task
+        return _MISSING
+
+    def work(index: int) -> None:
+        own = LocalWrapper(deques[index])
+        while not failed:
+            try:
+                task = own.pop()
+            except RuntimeError:
+                task = steal(index)
+                if task is _MISSING:
+                    return
+            try:
+                chunk_fn(index, task)  # pyre-ignore[6]
+            except BaseException as error:  # noqa: B902
+                errors.append(error)
+                failed.set(True)
+                return
+
+    threads = [
+        threading.Thread(target=work, args=(index,)) for index in range(1, workers)
+    ]
+    for thread in threads:
+        thread.start()
+    work(0)
+    for thread in threads:
+        thread.join()
+    if errors:
+        raise errors[0]
+
+
+def parallel_map(
+    fn: Callable[[_T], _R],
+    iterable: Iterable[_T],
+    workers: int | None = None,
+    chunk_size: int | None = None,
+) -> list[_R]:
+    """
+    Apply fn to every item of iterable across worker threads and return the
+    results in input order.
+
+    The input is split into chunks dealt onto per-worker ConcurrentDeques;
+    idle workers steal chunks from busy ones, so scaling stays near linear
+    on free-threaded builds even when item costs are uneven. An exception
+    in fn stops the remaining work and is re-raised here.
+
+    Args:
+    fn: The function to apply to each item.
+    iterable: The items to process; consumed eagerly.
+    workers (int | None): Worker thread count. Defaults to os.cpu_count().
+    chunk_size (int | None): Items per scheduling chunk. Defaults to a few
+    chunks per worker.
+    """
+    items: list[_T] = list(iterable)
+    results: list[_R] = [None] * len(items)  # pyre-ignore[9]
+
+    def chunk_fn(worker_index: int, task: tuple[int, Sequence[_T]]) -> None:
+        offset, chunk = task
+        # Each chunk owns a disjoint slice of results so no locking is
+        # needed to write them back.
+        for position, value in enumerate(chunk):
+            results[offset + position] = fn(value)
+
+    _run_chunked(chunk_fn, items, workers, chunk_size)  # pyre-ignore[6]
+    return results
+
+
+def map_reduce(
+    map_fn: Callable[[_T], _R],
+    reduce_fn: Callable[[_R, _R], _R],
+    iterable: Iterable[_T],
+    initial: _R = _MISSING,  # pyre-ignore[9]
+    workers: int | None = None,
+    chunk_size: int | None = None,
+) -> _R:
+    """
+    Map every item of iterable with map_fn and combine the mapped values
+    with reduce_fn across worker threads.
+
+    Each worker folds the values it processes into a private partial
+    result, and the partials are combined once the workers finish, so
+    reduce_fn runs without any cross-thread coordination on the hot path.
+    Because work stealing makes the grouping of items arbitrary, reduce_fn
+    must be associative and commutative (sums, mins, unions and the like).
+    An exception in either function stops the remaining work and is
+    re-raised here.
+
+    Args:
+    map_fn: The function applied to each item.
+    reduce_fn: The function combining two mapped values.
+    iterable: The items to process; consumed eagerly.
+    initial: Starting value folded into the result; without it an empty
+    iterable raises TypeError, matching functools.reduce.
+    workers (int | None): Worker thread count. Defaults to os.cpu_count().
+    chunk_size (int | None): Items per scheduling chunk.
+    """
+    items: list[_T] = list(iterable)
+    partials: ConcurrentDict[int, _R] = ConcurrentDict()
+
+    def chunk_fn(worker_index: int, task: tuple[int, Sequence[_T]]) -> None:
+        _, chunk = task
+        accumulator = partials.get(worker_index, _MISSING)
+        for value in chunk:
+            mapped = map_fn(value)
+            if accumulator is _MISSING:
+                accumulator = mapped
             else:
-                _sleep(0.05)
+                accumulator = reduce_fn(accumulator, mapped)  # pyre-ignore[6]
+        partials[worker_index] = accumulator  # pyre-ignore[6]
+
+    _run_chunked(chunk_fn, items, workers, chunk_size)  # pyre-ignore[6]
+
+    result = initial
+    for worker_index in sorted(partials.keys()):
+        partial = partials[worker_index]
+        if result is _MISSING:
+            result = partial
+        else:
+            result = reduce_fn(result, partial)
+    if result is _MISSING:
+        raise TypeError("map_reduce() of empty iterable with no initial value")
+    return result
@@ -4,7 +4,13 @@
 
 from typing import Any, Callable, Iterator, Optional, SupportsIndex
 
-__all__ = ["LocalWrapper", "get_local_wrapper", "release_local_wrapper", "__version__"]
+__all__ = [
+    "LocalWrapper",
+    "get_local_wrapper",
+    "localize",
+    "release_local_wrapper",
+    "__version__",
+]
 
 class LocalWrapper:
     wrapped: Any
@@ -104,12 +110,15 @@ class LocalWrapper:
     def del_wrapped(self) -> None: ...
 
 class BatchExecutor:
-    def __init__(self, source: Callable[[], Any], size: int) -> None: ...
+    def __init__(
+        self, source: Callable[[], Any], size: int, chunk_size: int = 0
+    ) -> None: ...
     def load(self) -> Any: ...
     def as_local(self) -> LocalWrapper: ...
 
 # Module level functions
 def get_local_wrapper(wrapped: Any) -> LocalWrapper: ...
+def localize(*objects: Any) -> tuple[LocalWrapper, ...]: ...
 def release_local_wrapper(wrapper: LocalWrapper) -> None: ...
 
 # Constants
@@ -11,6 +11,7 @@ import sys
 import threading
 import time
 
+from ft_utils import parallel_sort
 from ft_utils.local import LocalWrapper
 
 
@@ -150,6 +151,34 @@ class MergeSortBenchmark:
         print(f"GIL Enabled: {gil_enabled}")
         return 0
 
+    def run_native(self) -> int:
+        # Same workload but sorted by the C layer; element moves and
+        # merges never enter the interpreter.
+        try:
+            os.sched_setaffinity(0, list(range(int(self.n_cpus))))
+        except AttributeError:
+            pass
+        # pyre-ignore
+        gil_enabled: bool = getattr(sys, "_is_gil_enabled", lambda: True)()
+        data: list[int] = list(self.target)
+        start_time: float = time.time()
+        parallel_sort(data, threads=int(self.max_threads * 2))
+        end_time: float = time.time()
+        total_time: float = end_time - start_time
+
+        for i in range(1, self.max_size):
+            if data[i - 1] > data[i]:
+                print(f"Error: Array is not sorted at position {i}.")
+                return -1
+
+        print("Array is correctly sorted.")
+        print(
+            f"Parameters: N_CPUS={self.n_cpus}, MAX_SIZE={self.max_size}, MAX_THREADS={self.max_threads * 2}, native"
+        )
+        print(f"Time taken: {total_time} seconds")
+        print(f"GIL Enabled: {gil_enabled}")
+        return 0
+
 
 def invoke_main() -> None:
     parser: argparse.ArgumentParser = argparse.ArgumentParser()
@@ -157,6 +186,7 @@ def invoke_main() -> None:
     parser.add_argument("--max_size", type=int, default=100000)
     parser.add_argument("--threshold", type=int, default=1000)
     parser.add_argument("--max_threads", type=int, default=2)
+    parser.add_argument("--native", action="store_true")
     args: argparse.Namespace = parser.parse_args()
     if args.max_threads < 2:
         raise ValueError("Minimum threads is 2")
@@ -164,7 +194,10 @@ def invoke_main() -> None:
     benchmark: MergeSortBenchmark = MergeSortBenchmark(
         args.n_cpus, args.max_size, args.threshold, args.max_threads
     )
-    benchmark.run()
+    if args.native:
+        benchmark.run_native()
+    else:
+        benchmark.run()
 
 
 if __name__ == "__main__":
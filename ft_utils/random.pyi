@@ -0,0 +1,13 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+from typing import Sequence, TypeVar
+
+T = TypeVar("T")
+
+def random() -> float: ...
+def randint(a: int, b: int) -> int: ...
+def choice(seq: Sequence[T]) -> T: ...
+def rand_ints(n: int) -> list[int]: ...
+def seed(n: int) -> None: ...
@@ -5,6 +5,7 @@
 import random
 import threading
 
+from ft_utils import random as ft_random
 from ft_utils.benchmark_utils import BenchmarkProvider, execute_benchmarks
 from ft_utils.local import BatchExecutor, LocalWrapper
 from ft_utils.synchronization import IntervalLock, RWLock, RWWriteContext
@@ -32,6 +33,11 @@ class RandomBenchmarkProvider(BenchmarkProvider):
                 _ = rr(1, 100)
                 poll()
 
+    def benchmark_ft_random(self) -> None:
+        rr = LocalWrapper(ft_random.randint)
+        for _ in range(self._operations):
+            _ = rr(1, 100)
+
     def benchmark_batch_executor(self) -> None:
         be = LocalWrapper(self._batch_executor.load)
         for _ in range(self._operations):
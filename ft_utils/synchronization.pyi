@@ -6,18 +6,20 @@ from types import TracebackType
 from typing import Optional, Type, Union
 
 class IntervalLock:
-    def __init__(self, interval: float = 0.005) -> None: ...
+    def __init__(self, interval: float = 0.005, adaptive: bool = False) -> None: ...
     def lock(self) -> None: ...
     def unlock(self) -> None: ...
     def poll(self) -> None: ...
     def cede(self) -> None: ...
     def locked(self) -> bool: ...
+    def stats(self) -> dict[str, Union[int, float]]: ...
     def __enter__(self) -> "IntervalLock": ...
     def __exit__(
         self, *args: Optional[Union[Type[BaseException], Exception, TracebackType]]
     ) -> None: ...
 
 class RWLock:
+    def __init__(self, striped: bool = False) -> None: ...
     def lock_read(self) -> None: ...
     def unlock_read(self) -> None: ...
     def lock_write(self) -> None: ...
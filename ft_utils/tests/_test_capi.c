@@ -0,0 +1,117 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+/* Exercises the public C API capsule exported by ft_utils._concurrency the
+   way a third party extension would: import the capsule once at module exec
+   and then call straight through the function pointers. */
+
+static FTUtils_CAPI* capi = NULL;
+
+static PyObject* test_dict_get(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject* dict;
+  PyObject* key;
+  if (!PyArg_ParseTuple(args, "OO", &dict, &key)) {
+    return NULL;
+  }
+  return capi->ConcurrentDict_GetItem(dict, key);
+}
+
+static PyObject* test_dict_set(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject* dict;
+  PyObject* key;
+  PyObject* value;
+  if (!PyArg_ParseTuple(args, "OOO", &dict, &key, &value)) {
+    return NULL;
+  }
+  if (capi->ConcurrentDict_SetItem(dict, key, value) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* test_dict_del(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject* dict;
+  PyObject* key;
+  if (!PyArg_ParseTuple(args, "OO", &dict, &key)) {
+    return NULL;
+  }
+  if (capi->ConcurrentDict_SetItem(dict, key, NULL) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* test_atomic_add(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject* atomic;
+  long long amount;
+  if (!PyArg_ParseTuple(args, "OL", &atomic, &amount)) {
+    return NULL;
+  }
+  int64_t result;
+  if (capi->AtomicInt64_Add(atomic, (int64_t)amount, &result) < 0) {
+    return NULL;
+  }
+  return PyLong_FromLongLong(result);
+}
+
+static PyObject* test_deque_push(PyObject* Py_UNUSED(module), PyObject* args) {
+  PyObject* deque;
+  PyObject* item;
+  if (!PyArg_ParseTuple(args, "OO", &deque, &item)) {
+    return NULL;
+  }
+  if (capi->ConcurrentDeque_Push(deque, item) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* test_deque_pop(PyObject* Py_UNUSED(module), PyObject* deque) {
+  return capi->ConcurrentDeque_Pop(deque);
+}
+
+static PyObject* test_deque_popleft(
+    PyObject* Py_UNUSED(module),
+    PyObject* deque) {
+  return capi->ConcurrentDeque_PopLeft(deque);
+}
+
+static PyMethodDef test_capi_methods[] = {
+    {"dict_get", test_dict_get, METH_VARARGS, "Get via the capsule."},
+    {"dict_set", test_dict_set, METH_VARARGS, "Set via the capsule."},
+    {"dict_del", test_dict_del, METH_VARARGS, "Delete via the capsule."},
+    {"atomic_add", test_atomic_add, METH_VARARGS, "Add via the capsule."},
+    {"deque_push", test_deque_push, METH_VARARGS, "Push via the capsule."},
+    {"deque_pop", test_deque_pop, METH_O, "Pop via the capsule."},
+    {"deque_popleft", test_deque_popleft, METH_O, "Popleft via the capsule."},
+    {NULL, NULL, 0, NULL}};
+
+static int exec_test_capi_module(PyObject* Py_UNUSED(module)) {
+  capi = FTUtils_ImportCAPI();
+  if (capi == NULL) {
+    return -1;
+  }
+  return 0;
+}
+
+static struct PyModuleDef_Slot test_capi_module_slots[] = {
+    {Py_mod_exec, exec_test_capi_module},
+    _PY_NOGIL_MODULE_SLOT // NOLINT
+    {0, NULL} /* sentinel */
+};
+
+static PyModuleDef test_capi_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "test_capi",
+    "Test the public C API capsule",
+    0,
+    test_capi_methods,
+    test_capi_module_slots,
+    NULL,
+    NULL,
+    NULL};
+
+PyMODINIT_FUNC PyInit__test_capi(void) {
+  return PyModuleDef_Init(&test_capi_module_def);
+}
@@ -0,0 +1,13 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-unsafe
+
+from typing import Any
+
+def dict_get(dict: Any, key: object) -> object: ...
+def dict_set(dict: Any, key: object, value: object) -> None: ...
+def dict_del(dict: Any, key: object) -> None: ...
+def atomic_add(atomic: Any, amount: int) -> int: ...
+def deque_push(deque: Any, item: object) -> None: ...
+def deque_pop(deque: Any) -> object: ...
+def deque_popleft(deque: Any) -> object: ...
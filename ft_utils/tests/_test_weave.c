@@ -191,6 +191,61 @@ static PyObject* test_weave_unregister_destructor_2(
   return PyLong_FromLong(unreg);
 }
 
+/* Allocate a spread of sizes from the thread's arena, checking alignment and
+ * that the memory is writable. The arena registers its own destructor so
+ * there is nothing to free here.
+ */
+static PyObject* test_weave_arena_exercise(
+    PyObject* Py_UNUSED(self),
+    PyObject* Py_UNUSED(args)) {
+  static const size_t sizes[] = {1, 7, 16, 64, 1000};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    void* allocation = wvls_arena_alloc(sizes[i]);
+    if (allocation == NULL) {
+      return NULL;
+    }
+    if (((uintptr_t)allocation % WVLS_ARENA_ALIGNMENT) != 0) {
+      PyErr_SetString(PyExc_RuntimeError, "Arena allocation misaligned");
+      return NULL;
+    }
+    memset(allocation, 0xAB, sizes[i]);
+  }
+  Py_RETURN_NONE;
+}
+
+/* Check that resetting the arena makes its memory available again: the first
+ * allocation after a reset lands where the first allocation before it did.
+ */
+static PyObject* test_weave_arena_reset_reuses(
+    PyObject* Py_UNUSED(self),
+    PyObject* Py_UNUSED(args)) {
+  wvls_arena_reset();
+  void* before = wvls_arena_alloc(32);
+  if (before == NULL) {
+    return NULL;
+  }
+  wvls_arena_reset();
+  void* after = wvls_arena_alloc(32);
+  if (after == NULL) {
+    return NULL;
+  }
+  return PyBool_FromLong(before == after);
+}
+
+/* Allocations larger than the standard chunk get their own chunk. */
+static PyObject* test_weave_arena_large(
+    PyObject* Py_UNUSED(self),
+    PyObject* Py_UNUSED(args)) {
+  size_t big = WVLS_ARENA_CHUNK_SIZE * 2;
+  void* allocation = wvls_arena_alloc(big);
+  if (allocation == NULL) {
+    return NULL;
+  }
+  memset(allocation, 1, big);
+  wvls_arena_reset();
+  Py_RETURN_NONE;
+}
+
 static PyMethodDef test_weave_module_methods[] = {
     {"reset", test_reset, METH_VARARGS, "Reset the destructor test values."},
     {"register_destructor_1",
@@ -221,6 +276,18 @@ static PyMethodDef test_weave_module_methods[] = {
      test_weave_get_destructor_called_2,
      METH_NOARGS,
      "Get the value of destructor_called_2"},
+    {"arena_exercise",
+     test_weave_arena_exercise,
+     METH_NOARGS,
+     "Allocate assorted sizes from the thread's arena."},
+    {"arena_reset_reuses",
+     test_weave_arena_reset_reuses,
+     METH_NOARGS,
+     "Check wvls_arena_reset makes arena memory reusable."},
+    {"arena_large",
+     test_weave_arena_large,
+     METH_NOARGS,
+     "Allocate more than a chunk from the thread's arena."},
     {NULL, NULL, 0, NULL},
 };
 
@@ -100,6 +100,78 @@ class TestBatchExecutorConsistency(unittest.TestCase):
         self.assertEqual(what_we_expect, results)
 
 
+class CountingCallable:
+    def __init__(self) -> None:
+        self.next_value: int = 0
+
+    def __call__(self) -> int:
+        value = self.next_value
+        self.next_value += 1
+        return value
+
+
+class TestChunkedBatchExecutor(unittest.TestCase):
+    def test_initialization_with_non_integer_chunk_size(self) -> None:
+        with self.assertRaises(TypeError):
+            BatchExecutor(simple_callable, 5, "two")  # pyre-ignore[6]
+
+    def test_initialization_with_negative_chunk_size(self) -> None:
+        with self.assertRaises(ValueError):
+            BatchExecutor(simple_callable, 5, -1)
+
+    def test_zero_chunk_size_is_shared_buffer_mode(self) -> None:
+        executor: BatchExecutor = BatchExecutor(simple_callable, 5, 0)
+        self.assertEqual(executor.load(), "result")
+
+    def test_single_thread_loads_in_order(self) -> None:
+        source: CountingCallable = CountingCallable()
+        executor: BatchExecutor = BatchExecutor(source, 100, 4)
+        self.assertEqual([executor.load() for _ in range(10)], list(range(10)))
+
+    def test_exception_in_callable(self) -> None:
+        executor: BatchExecutor = BatchExecutor(failing_callable, 5, 4)
+        with self.assertRaises(Exception) as context:
+            executor.load()
+        self.assertTrue("Intentional Failure" in str(context.exception))
+        with self.assertRaises(RuntimeError):
+            executor.load()
+
+    def test_multithreaded_loads_are_distinct(self) -> None:
+        source: CountingCallable = CountingCallable()
+        executor: BatchExecutor = BatchExecutor(source, 100, 4)
+
+        def load_many() -> list[int]:
+            return [executor.load() for _ in range(64)]
+
+        with ThreadPoolExecutor(max_workers=8) as pool:
+            futures: list[Future[list[int]]] = [
+                pool.submit(load_many) for _ in range(8)
+            ]
+            results: list[int] = []
+            for future in futures:
+                results.extend(future.result())
+
+        # Every loaded value is unique and was produced by the source.
+        self.assertEqual(len(results), 8 * 64)
+        self.assertEqual(len(set(results)), len(results))
+        self.assertTrue(all(0 <= value < source.next_value for value in results))
+
+    def test_cyclic_garbage_collection_with_chunks(self) -> None:
+        callable_instance: SelfReferencingCallable = SelfReferencingCallable()
+        executor: BatchExecutor = BatchExecutor(callable_instance, 5, 4)
+        callable_instance.set_executor(executor)
+        weak_ref: weakref.ref[BatchExecutor] = weakref.ref(executor)
+        # Leave unconsumed items behind in this thread's chunk.
+        executor.load()
+
+        del executor
+        del callable_instance
+
+        while gc.collect():
+            pass
+        self.assertIsNone(weak_ref(), "Executor should have been garbage collected")
+
+
 class SelfReferencingCallable:
     def __init__(self) -> None:
         self.executor: BatchExecutor | None = None
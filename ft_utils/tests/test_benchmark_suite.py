@@ -0,0 +1,124 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+import sys
+import types
+import unittest
+
+from ft_utils.benchmark_suite import (
+    compare_to_baseline,
+    discover_bench_modules,
+    find_providers,
+    run_suite,
+    summarize,
+    SuiteType,
+)
+from ft_utils.benchmark_utils import BenchmarkProvider
+
+
+class FakeProvider(BenchmarkProvider):
+    calls: int = 0
+
+    def benchmark_noop(self) -> None:
+        self.__class__.calls += 1
+
+
+class TestBenchmarkSuite(unittest.TestCase):
+    def test_discover_bench_modules(self) -> None:
+        modules = discover_bench_modules()
+        self.assertIn("ft_utils.atomic_bench", modules)
+        self.assertIn("ft_utils.lock_bench", modules)
+        self.assertTrue(all(name.endswith("_bench") for name in modules))
+
+    def test_find_providers(self) -> None:
+        module = types.ModuleType("fake_bench")
+        FakeProvider.__module__ = module.__name__
+        module.FakeProvider = FakeProvider  # pyre-ignore[16]
+        module.BenchmarkProvider = BenchmarkProvider  # pyre-ignore[16]
+        self.assertEqual(find_providers(module), [FakeProvider])
+
+    def test_summarize(self) -> None:
+        summary = summarize([0.1, 0.2, 0.3, 0.4], operations=100, threads=2)
+        self.assertEqual(summary["runs"], 4)
+        self.assertAlmostEqual(float(summary["mean"]), 0.25)
+        self.assertAlmostEqual(float(summary["p50"]), 0.3)
+        self.assertAlmostEqual(float(summary["p99"]), 0.4)
+        self.assertAlmostEqual(float(summary["ops_per_sec"]), 2 * 100 / 0.25)
+
+    def test_run_suite(self) -> None:
+        module = types.ModuleType("fake_bench")
+        FakeProvider.__module__ = module.__name__
+        module.FakeProvider = FakeProvider  # pyre-ignore[16]
+        sys.modules["fake_bench"] = module
+        try:
+            FakeProvider.calls = 0
+            suite = run_suite(
+                ["fake_bench"], operations=1, thread_counts=[1, 2], repeats=2
+            )
+        finally:
+            del sys.modules["fake_bench"]
+        self.assertGreater(FakeProvider.calls, 0)
+        results = suite["results"]
+        assert isinstance(results, dict)
+        by_threads = results["fake_bench"]["noop"]
+        self.assertEqual(set(by_threads), {"1", "2"})
+        self.assertEqual(by_threads["1"]["runs"], 2)
+        self.assertEqual(by_threads["2"]["runs"], 4)
+        self.assertIn("scaling_efficiency", by_threads["2"])
+
+    def test_run_suite_filter(self) -> None:
+        module = types.ModuleType("fake_bench")
+        FakeProvider.__module__ = module.__name__
+        module.FakeProvider = FakeProvider  # pyre-ignore[16]
+        sys.modules["fake_bench"] = module
+        try:
+            suite = run_suite(
+                ["fake_bench"],
+                operations=1,
+                thread_counts=[1],
+                repeats=1,
+                name_filter="no_such_benchmark",
+            )
+        finally:
+            del sys.modules["fake_bench"]
+        self.assertEqual(suite["results"], {})
+
+    def _suite_with_ops_per_sec(self, ops_per_sec: float) -> SuiteType:
+        return {
+            "metadata": {},
+            "results": {
+                "fake_bench": {
+                    "noop": {
+                        "1": {
+                            "runs": 1,
+                            "mean": 1.0,
+                            "p50": 1.0,
+                            "p99": 1.0,
+                            "ops_per_sec": ops_per_sec,
+                        }
+                    }
+                }
+            },
+        }
+
+    def test_compare_to_baseline_regression(self) -> None:
+        baseline = self._suite_with_ops_per_sec(1000.0)
+        current = self._suite_with_ops_per_sec(500.0)
+        regressions = compare_to_baseline(current, baseline, threshold=0.1)
+        self.assertEqual(len(regressions), 1)
+        self.assertIn("fake_bench.noop", regressions[0])
+
+    def test_compare_to_baseline_within_threshold(self) -> None:
+        baseline = self._suite_with_ops_per_sec(1000.0)
+        current = self._suite_with_ops_per_sec(950.0)
+        self.assertEqual(compare_to_baseline(current, baseline, threshold=0.1), [])
+
+    def test_compare_to_baseline_missing_entries(self) -> None:
+        current = self._suite_with_ops_per_sec(500.0)
+        empty: SuiteType = {"metadata": {}, "results": {}}
+        self.assertEqual(compare_to_baseline(current, empty, threshold=0.1), [])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -6,8 +6,10 @@ import sys
 import unittest
 from unittest.mock import MagicMock, patch
 
+from ft_utils import _timing
 from ft_utils.benchmark_utils import (
     benchmark_operation,
+    benchmark_operation_distribution,
     BenchmarkProvider,
     execute_benchmarks,
     ft_randchoice,
@@ -19,10 +21,14 @@ from ft_utils.benchmark_utils import (
 
 class FakeBench(BenchmarkProvider):
     ran: bool = False
+    latency_ran: bool = False
 
     def benchmark_foo(self) -> None:
         self.__class__.ran = True
 
+    def latency_bar(self) -> None:
+        self.__class__.latency_ran = True
+
 
 class TestBenchmarkUtils(unittest.TestCase):
     def test_ft_randint(self) -> None:
@@ -77,8 +83,51 @@ class TestBenchmarkUtils(unittest.TestCase):
         ]
         with patch.object(sys, "argv", test_args):
             FakeBench.ran = False
+            FakeBench.latency_ran = False
             execute_benchmarks(FakeBench)
             self.assertTrue(FakeBench.ran)
+            self.assertTrue(FakeBench.latency_ran)
+
+
+class TestTimingBench(unittest.TestCase):
+    def test_bench_counts_every_call(self) -> None:
+        calls: list[int] = []
+        stats = _timing.bench(lambda: calls.append(0), 1000, 64)
+        self.assertEqual(stats["count"], 1000)
+        self.assertEqual(len(calls), 1000)
+
+    def test_bench_stats_are_ordered(self) -> None:
+        stats = _timing.bench(lambda: None, 1000, 100)
+        self.assertLessEqual(stats["min_ns"], stats["p50_ns"])
+        self.assertLessEqual(stats["p50_ns"], stats["p99_ns"])
+        self.assertLessEqual(stats["p99_ns"], stats["p999_ns"])
+        self.assertGreater(stats["mean_ns"], 0.0)
+        self.assertGreaterEqual(stats["total_ns"], stats["max_ns"])
+
+    def test_bench_rejects_bad_arguments(self) -> None:
+        with self.assertRaises(TypeError):
+            _timing.bench(42, 10)  # pyre-ignore[6]
+        with self.assertRaises(ValueError):
+            _timing.bench(lambda: None, 0)
+        with self.assertRaises(ValueError):
+            _timing.bench(lambda: None, 10, 0)
+
+    def test_bench_propagates_exceptions(self) -> None:
+        def boom() -> None:
+            raise RuntimeError("boom")
+
+        with self.assertRaises(RuntimeError):
+            _timing.bench(boom, 10)
+
+    def test_ns_clock_monotonic(self) -> None:
+        first: int = _timing.ns_clock()
+        second: int = _timing.ns_clock()
+        self.assertGreaterEqual(second, first)
+
+    def test_benchmark_operation_distribution(self) -> None:
+        stats = benchmark_operation_distribution(lambda: None, iterations=500)
+        self.assertEqual(stats["count"], 500)
+        self.assertIn("p99_ns", stats)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,87 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+import unittest
+
+from ft_utils.concurrency import AtomicInt64, ConcurrentDeque, ConcurrentDict
+
+try:
+    import ft_utils._test_capi as _test_capi
+except ImportError:
+    # @manual
+    import ft_utils.tests._test_capi as _test_capi  # pyre-ignore[21]
+
+
+class TestCAPI(unittest.TestCase):
+    def test_dict_set_get(self) -> None:
+        dct = ConcurrentDict()
+        _test_capi.dict_set(dct, "key", 42)
+        self.assertEqual(_test_capi.dict_get(dct, "key"), 42)
+        self.assertEqual(dct["key"], 42)
+        dct["other"] = "value"
+        self.assertEqual(_test_capi.dict_get(dct, "other"), "value")
+
+    def test_dict_del(self) -> None:
+        dct = ConcurrentDict()
+        dct["key"] = 1
+        _test_capi.dict_del(dct, "key")
+        with self.assertRaises(KeyError):
+            _test_capi.dict_get(dct, "key")
+
+    def test_dict_missing_key(self) -> None:
+        dct = ConcurrentDict()
+        with self.assertRaises(KeyError):
+            _test_capi.dict_get(dct, "missing")
+
+    def test_dict_type_check(self) -> None:
+        with self.assertRaises(TypeError):
+            _test_capi.dict_set({}, "key", 1)
+        with self.assertRaises(TypeError):
+            _test_capi.dict_get([], "key")
+
+    def test_atomic_add(self) -> None:
+        atomic = AtomicInt64(10)
+        self.assertEqual(_test_capi.atomic_add(atomic, 5), 15)
+        self.assertEqual(int(atomic), 15)
+        self.assertEqual(_test_capi.atomic_add(atomic, -20), -5)
+        self.assertEqual(int(atomic), -5)
+
+    def test_atomic_type_check(self) -> None:
+        with self.assertRaises(TypeError):
+            _test_capi.atomic_add(7, 5)
+
+    def test_deque_push_pop(self) -> None:
+        deque = ConcurrentDeque()
+        _test_capi.deque_push(deque, 1)
+        _test_capi.deque_push(deque, 2)
+        _test_capi.deque_push(deque, 3)
+        self.assertEqual(list(deque), [1, 2, 3])
+        self.assertEqual(_test_capi.deque_pop(deque), 3)
+        self.assertEqual(_test_capi.deque_popleft(deque), 1)
+        self.assertEqual(list(deque), [2])
+
+    def test_deque_pop_empty(self) -> None:
+        deque = ConcurrentDeque()
+        with self.assertRaises(RuntimeError):
+            _test_capi.deque_pop(deque)
+        with self.assertRaises(RuntimeError):
+            _test_capi.deque_popleft(deque)
+
+    def test_deque_type_check(self) -> None:
+        with self.assertRaises(TypeError):
+            _test_capi.deque_push([], 1)
+        with self.assertRaises(TypeError):
+            _test_capi.deque_pop([])
+
+    def test_interop_with_python_side(self) -> None:
+        deque = ConcurrentDeque([1, 2])
+        _test_capi.deque_push(deque, 3)
+        deque.append(4)
+        self.assertEqual(list(deque), [1, 2, 3, 4])
+        self.assertEqual(deque.pop(), 4)
+        self.assertEqual(_test_capi.deque_pop(deque), 3)
+
+
+if __name__ == "__main__":
+    unittest.main()
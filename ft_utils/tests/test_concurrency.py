@@ -3,15 +3,20 @@
 # pyre-strict
 
 import gc
+import os
 import queue
+import subprocess
+import sys
 import threading
 import time
 import unittest
+import uuid
 import weakref
 from typing import Callable
 
 import ft_utils.concurrency as concurrency
 import ft_utils.local as local
+from ft_utils._concurrency import ConcurrentQueue as NativeConcurrentQueue
 from ft_utils.threading_test_utils import run_concurrently, run_each_concurrently
 
 
@@ -521,6 +526,196 @@ class TestConcurrentDict(unittest.TestCase):
         self.assertEqual(len(results), 1000)
         self.assertCountEqual(results, [i * 2 for i in range(1000)])
 
+    def test_int_key_edge_cases(self) -> None:
+        # hash(-1) is -2 and huge ints wrap; both must land in a stable shard.
+        dct: concurrency.ConcurrentDict[int, str] = concurrency.ConcurrentDict(7)
+        for key in (-1, -2, 0, 2**70, -(2**70), 2**63 - 1):
+            dct[key] = str(key)
+        for key in (-1, -2, 0, 2**70, -(2**70), 2**63 - 1):
+            self.assertEqual(dct[key], str(key))
+            del dct[key]
+        self.assertEqual(len(dct), 0)
+
+    def test_str_subclass_key_uses_custom_hash(self) -> None:
+        class Loud(str):
+            def __hash__(self) -> int:
+                return 42
+
+            def __eq__(self, other: object) -> bool:
+                return isinstance(other, Loud) and str.__eq__(self, other)
+
+        dct: concurrency.ConcurrentDict[object, int] = concurrency.ConcurrentDict(7)
+        dct[Loud("a")] = 1
+        dct[Loud("b")] = 2
+        self.assertEqual(dct[Loud("a")], 1)
+        self.assertEqual(dct[Loud("b")], 2)
+        self.assertNotIn("a", dct)
+
+    def test_int_subclass_key_uses_custom_hash(self) -> None:
+        class Wrapped(int):
+            def __hash__(self) -> int:
+                return 7
+
+            def __eq__(self, other: object) -> bool:
+                return isinstance(other, Wrapped) and int.__eq__(self, other)
+
+        dct: concurrency.ConcurrentDict[object, int] = concurrency.ConcurrentDict(7)
+        dct[Wrapped(1)] = 1
+        dct[Wrapped(2)] = 2
+        self.assertEqual(dct[Wrapped(1)], 1)
+        self.assertEqual(dct[Wrapped(2)], 2)
+        self.assertNotIn(1, dct)
+
+    def test_iter_snapshot(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        for i in range(1000):
+            dct[i] = i * 2
+        self.assertCountEqual(list(dct.iter_snapshot()), list(range(1000)))
+        self.assertCountEqual(
+            list(dct.items_snapshot()), [(i, i * 2) for i in range(1000)]
+        )
+
+    def test_iter_snapshot_empty(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        self.assertEqual(list(dct.iter_snapshot()), [])
+        self.assertEqual(list(dct.items_snapshot()), [])
+
+    def test_iter_snapshot_mutation_does_not_break_iteration(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict(5)
+        for i in range(100):
+            dct[i] = i
+        seen = []
+        it = dct.items_snapshot()
+        for key, value in it:
+            # Mutating during iteration would raise with a plain dict; the
+            # snapshot iterator keeps going over its per-shard copies.
+            dct[key + 1000] = value
+            seen.append(key)
+        self.assertCountEqual([k for k in seen if k < 1000], list(range(100)))
+
+    def test_iter_snapshot_threads(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict(37)
+        for i in range(1000):
+            dct[i] = i
+
+        def writer() -> None:
+            for i in range(1000, 2000):
+                dct[i] = i
+
+        def scanner() -> None:
+            seen = {k for k in dct.iter_snapshot() if k < 1000}
+            self.assertEqual(seen, set(range(1000)))
+
+        run_each_concurrently([writer, scanner, writer, scanner])
+
+    def test_update_batch(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        dct.update_batch([(i, i * 2) for i in range(1000)])
+        self.assertEqual(len(dct), 1000)
+        for i in range(1000):
+            self.assertEqual(dct[i], i * 2)
+
+    def test_update_batch_bad_pairs(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        with self.assertRaises(TypeError):
+            dct.update_batch([(1, 2), (3,)])  # pyre-ignore[6]
+
+    def test_get_many(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        for i in range(100):
+            dct[i] = i * 2
+        self.assertEqual(dct.get_many([3, 5, 7]), [6, 10, 14])
+        self.assertEqual(dct.get_many([3, 1000]), [6, None])
+        self.assertEqual(dct.get_many([3, 1000], -1), [6, -1])
+        self.assertEqual(dct.get_many([]), [])
+
+    def test_pop_many(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+        for i in range(100):
+            dct[i] = i * 2
+        self.assertEqual(dct.pop_many([3, 5]), [6, 10])
+        self.assertNotIn(3, dct)
+        self.assertNotIn(5, dct)
+        self.assertEqual(dct.pop_many([5, 7], -1), [-1, 14])
+        with self.assertRaisesRegex(KeyError, "5"):
+            dct.pop_many([9, 5])
+        # Keys before the failing one stay removed.
+        self.assertNotIn(9, dct)
+
+    def test_update_batch_threads(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict()
+
+        def writer(base: int) -> None:
+            dct.update_batch([(base + i, i) for i in range(1000)])
+
+        run_each_concurrently(
+            [lambda b=base: writer(b) for base in range(0, 4000, 1000)]  # pyre-ignore
+        )
+        self.assertEqual(len(dct), 4000)
+
+    def test_growable_smoke(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict(
+            growable=True
+        )
+        dct[1] = 2
+        self.assertEqual(dct[1], 2)
+        del dct[1]
+        with self.assertRaisesRegex(KeyError, "1"):
+            dct[1]
+
+    def test_growable_big(self) -> None:
+        dct: concurrency.ConcurrentDict[object, object] = concurrency.ConcurrentDict(
+            3, growable=True
+        )
+        for i in range(10000):
+            dct[i] = i + 1
+        for i in range(10000):
+            self.assertEqual(dct[i], i + 1)
+        for i in range(10000):
+            dct[str(i)] = str(i * 2)
+        self.assertEqual(len(dct), 20000)
+        for i in range(10000):
+            self.assertEqual(dct[str(i)], str(i * 2))
+        self.assertEqual(dct.as_dict(), dict(dct.items()))
+
+    def test_growable_delete_during_growth(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict(
+            3, growable=True
+        )
+        for i in range(5000):
+            dct[i] = i
+        for i in range(0, 5000, 2):
+            del dct[i]
+        self.assertEqual(len(dct), 2500)
+        self.assertCountEqual(dct.keys(), list(range(1, 5000, 2)))
+
+    def test_growable_threads(self) -> None:
+        dct: concurrency.ConcurrentDict[object, object] = concurrency.ConcurrentDict(
+            3, growable=True
+        )
+
+        def win() -> None:
+            for i in range(5000):
+                dct[i] = i + 1
+
+        def wstr() -> None:
+            for i in range(5000):
+                dct[str(i)] = str(i * 2)
+
+        run_each_concurrently([win, wstr, win, wstr])
+        for i in range(5000):
+            self.assertEqual(dct[i], i + 1)
+        for i in range(5000):
+            self.assertEqual(dct[str(i)], str(i * 2))
+        self.assertEqual(len(dct), 10000)
+
+    def test_not_growable_by_default(self) -> None:
+        dct: concurrency.ConcurrentDict[int, int] = concurrency.ConcurrentDict(3)
+        for i in range(5000):
+            dct[i] = i
+        self.assertEqual(len(dct), 5000)
+        self.assertEqual(dct[4999], 4999)
+
 
 class TestConcurrentDictGC(unittest.TestCase):
     def setUp(self) -> None:
@@ -720,6 +915,118 @@ class TestAtomicInt64(unittest.TestCase):
         self.assertEqual(f"{ai:d}", "10")
 
 
+class TestAtomicFlag(unittest.TestCase):
+    def test_smoke(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(False)
+        self.assertFalse(flag)
+        flag.set(True)
+        self.assertTrue(flag)
+        flag.set(False)
+        self.assertFalse(flag)
+
+    def test_wait_already_satisfied(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(True)
+        self.assertTrue(flag.wait_until_set())
+        self.assertTrue(flag.wait_until_set(0.0))
+        flag.set(False)
+        self.assertTrue(flag.wait_until_clear())
+
+    def test_wait_timeout(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(False)
+        self.assertFalse(flag.wait_until_set(0.05))
+        flag.set(True)
+        self.assertFalse(flag.wait_until_clear(0.05))
+
+    def test_wait_until_set_threads(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(False)
+
+        def worker() -> None:
+            time.sleep(0.05)
+            flag.set(True)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        self.assertTrue(flag.wait_until_set(5))
+        t.join()
+
+    def test_wait_until_clear_threads(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(True)
+
+        def worker() -> None:
+            time.sleep(0.05)
+            flag.set(False)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        self.assertTrue(flag.wait_until_clear(5))
+        t.join()
+
+    def test_many_waiters(self) -> None:
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(False)
+        results: list[bool] = []
+
+        def waiter() -> None:
+            results.append(flag.wait_until_set(5))
+
+        threads = [threading.Thread(target=waiter) for _ in range(4)]
+        for t in threads:
+            t.start()
+        flag.set(True)
+        for t in threads:
+            t.join()
+        self.assertEqual(results, [True] * 4)
+
+
+class TestAtomicInt64Array(unittest.TestCase):
+    def test_smoke(self) -> None:
+        arr = concurrency.AtomicInt64Array(4)
+        self.assertEqual(len(arr), 4)
+        self.assertEqual(arr.to_list(), [0, 0, 0, 0])
+        arr.incr(1)
+        arr.add(2, 10)
+        arr.decr(3)
+        self.assertEqual(arr.get(1), 1)
+        self.assertEqual(arr[2], 10)
+        self.assertEqual(arr.to_list(), [0, 1, 10, -1])
+        arr.set(2, 5)
+        self.assertEqual(arr.get(2), 5)
+
+    def test_bounds(self) -> None:
+        arr = concurrency.AtomicInt64Array(4)
+        with self.assertRaises(IndexError):
+            arr.get(4)
+        with self.assertRaises(IndexError):
+            arr.incr(-1)
+        with self.assertRaises(IndexError):
+            arr.add(100, 1)
+
+    def test_empty(self) -> None:
+        arr = concurrency.AtomicInt64Array(0)
+        self.assertEqual(len(arr), 0)
+        self.assertEqual(arr.to_list(), [])
+
+    def test_striped(self) -> None:
+        arr = concurrency.AtomicInt64Array(4, striped=True)
+        for _ in range(100):
+            arr.incr(0)
+        arr.add(1, 7)
+        self.assertEqual(arr.get(0), 100)
+        self.assertEqual(arr.to_list(), [100, 7, 0, 0])
+        arr.set(0, 3)
+        self.assertEqual(arr.get(0), 3)
+
+    def test_threads(self) -> None:
+        for striped in (False, True):
+            arr = concurrency.AtomicInt64Array(8, striped=striped)
+
+            def worker(n: int) -> None:
+                for i in range(n):
+                    arr.incr(i % 8)  # pyre-ignore
+
+            run_concurrently(worker, 10, args=(800,))
+            self.assertEqual(arr.to_list(), [1000] * 8)
+
+
 class BreakingDict(dict[object, object]):
     def __setitem__(self, key: object, value: object) -> None:
         raise RuntimeError("Cannot assign to this dictionary")
@@ -955,6 +1262,223 @@ class TestConcurrentQueueLockFree(TestConcurrentQueue):
         return concurrency.ConcurrentQueue(lock_free=True)
 
 
+class TestNativeConcurrentQueue(unittest.TestCase):
+    def _get_queue(self) -> NativeConcurrentQueue:
+        return NativeConcurrentQueue()
+
+    def test_smoke(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        q.push(10)
+        self.assertEqual(q.pop(), 10)
+        self.assertTrue(q.empty())
+        self.assertEqual(q.size(), 0)
+
+    def test_fifo_order(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        for i in range(100):
+            q.push(i)
+        self.assertEqual(q.size(), 100)
+        for i in range(100):
+            self.assertEqual(q.pop(), i)
+
+    def test_pop_timeout_expires(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        start = time.monotonic()
+        with self.assertRaises(concurrency.Empty):
+            q.pop(timeout=0.05)
+        self.assertGreaterEqual(time.monotonic() - start, 0.04)
+
+    def test_pop_blocks_until_push(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+
+        def worker() -> None:
+            time.sleep(0.1)
+            q.push(10)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        self.assertEqual(q.pop(), 10)
+        t.join()
+
+    def test_shutdown(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        q.push(1)
+        q.shutdown()
+        with self.assertRaises(concurrency.ShutDown):
+            q.push(2)
+        # Pending values drain before ShutDown is raised.
+        self.assertEqual(q.pop(), 1)
+        with self.assertRaises(concurrency.ShutDown):
+            q.pop()
+
+    def test_shutdown_immediate(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        q.push(1)
+        q.shutdown(immediate=True)
+        with self.assertRaises(concurrency.ShutDown):
+            q.pop()
+
+    def test_shutdown_wakes_waiters(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+
+        def waiter() -> None:
+            with self.assertRaises(concurrency.ShutDown):
+                q.pop()
+
+        def closer() -> None:
+            time.sleep(0.1)
+            q.shutdown()
+
+        run_each_concurrently([waiter, waiter, closer])
+
+    def test_threads(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        nthread = 4
+        count = 1000
+        popped: list[list[object]] = [[] for _ in range(nthread)]
+
+        def producer(base: int) -> None:
+            for i in range(count):
+                q.push(base + i)
+
+        def consumer(results: list[object]) -> None:
+            while True:
+                try:
+                    results.append(q.pop(timeout=2.0))
+                except concurrency.ShutDown:
+                    break
+
+        def closer() -> None:
+            time.sleep(0.3)
+            q.shutdown()
+
+        run_each_concurrently(
+            [lambda b=base * count: producer(b) for base in range(nthread)]  # pyre-ignore
+            + [lambda r=results: consumer(r) for results in popped]  # pyre-ignore
+            + [closer]
+        )
+        drained: list[object] = []
+        for results in popped:
+            drained.extend(results)
+        self.assertCountEqual(drained, list(range(nthread * count)))
+
+    def test_gc(self) -> None:
+        q: NativeConcurrentQueue = self._get_queue()
+        q.push(q)
+        ref = weakref.ref(q)
+        del q
+        gc.collect()
+        self.assertIsNone(ref())
+
+
+class TestConcurrentRingQueue(unittest.TestCase):
+    def test_smoke(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(4)
+        q.push(10)
+        self.assertEqual(q.pop(), 10)
+        self.assertTrue(q.empty())
+        self.assertFalse(q.full())
+
+    def test_capacity_rounds_up(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(5)
+        self.assertEqual(q.capacity(), 8)
+        # A single slot cannot distinguish empty from full, so two is the floor.
+        self.assertEqual(concurrency.ConcurrentRingQueue(1).capacity(), 2)
+        with self.assertRaises(ValueError):
+            concurrency.ConcurrentRingQueue(0)
+
+    def test_fifo_order(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(128)
+        for i in range(100):
+            q.push(i)
+        self.assertEqual(q.size(), 100)
+        for i in range(100):
+            self.assertEqual(q.pop(), i)
+
+    def test_full_timeout(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(2)
+        q.push(1)
+        q.push(2)
+        self.assertTrue(q.full())
+        with self.assertRaises(concurrency.Full):
+            q.push(3, timeout=0.05)
+
+    def test_empty_timeout(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(2)
+        with self.assertRaises(concurrency.Empty):
+            q.pop(timeout=0.05)
+
+    def test_push_blocks_until_pop(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(2)
+        q.push(1)
+        q.push(2)
+
+        def worker() -> None:
+            time.sleep(0.1)
+            self.assertEqual(q.pop(), 1)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        q.push(3)
+        t.join()
+        self.assertEqual(q.pop(), 2)
+        self.assertEqual(q.pop(), 3)
+
+    def test_shutdown(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(4)
+        q.push(1)
+        q.shutdown()
+        with self.assertRaises(concurrency.ShutDown):
+            q.push(2)
+        self.assertEqual(q.pop(), 1)
+        with self.assertRaises(concurrency.ShutDown):
+            q.pop()
+
+    def test_shutdown_immediate(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(4)
+        q.push(1)
+        q.shutdown(immediate=True)
+        with self.assertRaises(concurrency.ShutDown):
+            q.pop()
+
+    def test_threads_saturated(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(16)
+        nthread = 4
+        count = 1000
+        popped: list[list[object]] = [[] for _ in range(nthread)]
+        done = concurrency.AtomicInt64(0)
+
+        def producer(base: int) -> None:
+            for i in range(count):
+                q.push(base + i)
+            if done.incr() == nthread:
+                q.shutdown()
+
+        def consumer(results: list[object]) -> None:
+            while True:
+                try:
+                    results.append(q.pop())
+                except concurrency.ShutDown:
+                    break
+
+        run_each_concurrently(
+            [lambda b=base * count: producer(b) for base in range(nthread)]  # pyre-ignore
+            + [lambda r=results: consumer(r) for results in popped]  # pyre-ignore
+        )
+        drained: list[object] = []
+        for results in popped:
+            drained.extend(results)
+        self.assertCountEqual(drained, list(range(nthread * count)))
+
+    def test_gc(self) -> None:
+        q: concurrency.ConcurrentRingQueue = concurrency.ConcurrentRingQueue(4)
+        q.push(q)
+        ref = weakref.ref(q)
+        del q
+        gc.collect()
+        self.assertIsNone(ref())
+
+
 class TestStdConcurrentQueue(unittest.TestCase):
     def _get_queue(self, maxsize: int = 0) -> concurrency.StdConcurrentQueue:
         return concurrency.StdConcurrentQueue(maxsize)
@@ -1118,6 +1642,60 @@ class TestStdConcurrentQueue(unittest.TestCase):
             q.put(32)
         t.join()
 
+    def test_put_blocks_until_get(self) -> None:
+        q: concurrency.StdConcurrentQueue = self._get_queue(maxsize=1)
+        q.put(1)
+        flag: concurrency.AtomicFlag = concurrency.AtomicFlag(False)
+
+        def worker() -> None:
+            flag.set(True)
+            q.put(2)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        while not flag:
+            pass
+        time.sleep(0.05)
+        self.assertEqual(q.get(), 1)
+        t.join()
+        self.assertEqual(q.get(), 2)
+
+    def test_put_timeout_full(self) -> None:
+        q: concurrency.StdConcurrentQueue = self._get_queue(maxsize=1)
+        q.put(1)
+        with self.assertRaises(queue.Full):
+            q.put(2, timeout=0.05)
+        self.assertEqual(q.get(), 1)
+
+    def test_join_wakes_on_task_done(self) -> None:
+        q: concurrency.StdConcurrentQueue = self._get_queue()
+        for i in range(5):
+            q.put(i)
+
+        def worker() -> None:
+            for _ in range(5):
+                q.get()
+                q.task_done()
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        q.join()
+        t.join()
+        self.assertEqual(int(q._active_tasks), 0)
+
+    def test_shutdown_immediate_ends_join(self) -> None:
+        q: concurrency.StdConcurrentQueue = self._get_queue()
+        q.put(1)
+
+        def worker() -> None:
+            time.sleep(0.05)
+            q.shutdown(immediate=True)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        q.join()
+        t.join()
+
 
 class TestConcurrentDeque(unittest.TestCase):
     class RichComparisonFailure:
@@ -1193,6 +1771,110 @@ class TestConcurrentDeque(unittest.TestCase):
             else:
                 self.assertIn(d.pop(), list(range(1, n_numbers, 2)))
 
+    def test_block_boundaries(self) -> None:
+        d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int](
+            range(300)
+        )
+        self.assertEqual(len(d), 300)
+        self.assertEqual(d[0], 0)
+        self.assertEqual(d[150], 150)
+        self.assertEqual(d[299], 299)
+        for _ in range(100):
+            d.popleft()
+        for _ in range(100):
+            d.pop()
+        self.assertEqual(len(d), 100)
+        self.assertEqual(list(d), list(range(100, 200)))
+        for i in range(100):
+            d.appendleft(-i)
+        self.assertEqual(len(d), 200)
+        self.assertEqual(d[0], -99)
+        self.assertEqual(d[199], 199)
+
+    def test_pop_steal(self) -> None:
+        d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int](
+            [1, 2, 3]
+        )
+        self.assertEqual(d.pop_steal(), 1)
+        self.assertEqual(d.pop_steal(), 2)
+        self.assertEqual(d.pop_steal(), 3)
+        self.assertIsNone(d.pop_steal())
+        self.assertEqual(d.pop_steal(-1), -1)
+
+    def test_pop_steal_concurrency(self) -> None:
+        d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int]()
+        count = 1000
+        stolen: list[list[int]] = [[] for _ in range(3)]
+        taken: list[int] = []
+
+        def owner() -> None:
+            for i in range(count):
+                d.append(i)
+                if i % 4 == 0:
+                    value = d.pop_steal(-1)
+                    if value != -1:
+                        taken.append(value)
+
+        def thief(results: list[int]) -> None:
+            misses = 0
+            while misses < 1000:
+                value = d.pop_steal(-1)
+                if value == -1:
+                    misses += 1
+                else:
+                    misses = 0
+                    results.append(value)
+
+        run_each_concurrently(
+            [owner] + [lambda r=results: thief(r) for results in stolen]  # pyre-ignore
+        )
+        leftover = []
+        while True:
+            value = d.pop_steal(-1)
+            if value == -1:
+                break
+            leftover.append(value)
+        everything = taken + leftover
+        for results in stolen:
+            everything.extend(results)
+        self.assertCountEqual(everything, list(range(count)))
+
+    def test_churn(self) -> None:
+        # Repeated fill/drain cycles recycle blocks through the internal
+        # pools; the contents must be identical to the fresh-allocation case.
+        d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int]()
+        for _ in range(5):
+            for i in range(500):
+                d.append(i)
+            for i in range(500):
+                self.assertEqual(d.popleft(), i)
+            self.assertEqual(len(d), 0)
+        d.extend(range(300))
+        for _ in range(3):
+            drained = [d.pop() for _ in range(300)]
+            self.assertEqual(drained, list(reversed(range(300))))
+            d.extend(range(300))
+        self.assertEqual(list(d), list(range(300)))
+
+    def test_churn_threads(self) -> None:
+        d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int]()
+        count = 500
+        popped: list[list[int]] = [[] for _ in range(4)]
+
+        def worker(results: list[int]) -> None:
+            for i in range(count):
+                d.append(i)
+                value = d.pop_steal(-1)
+                if value != -1:
+                    results.append(value)
+
+        run_each_concurrently(
+            [lambda r=results: worker(r) for results in popped]  # pyre-ignore
+        )
+        leftover = list(d)
+        total = sum(len(results) for results in popped) + len(leftover)
+        self.assertEqual(total, count * 4)
+
     def test_clear(self) -> None:
         d: concurrency.ConcurrentDeque[int] = concurrency.ConcurrentDeque[int](
             [1, 2, 3, 4, 5]
@@ -1618,6 +2300,65 @@ class TestConcurrentGatheringIterator(unittest.TestCase):
         iterator.insert(0, 10)
         self.assertEqual(list(iterator.iterator(0, clear=True)), [10])
 
+    def test_next_n_drains_contiguous(self) -> None:
+        iterator: concurrency.ConcurrentGatheringIterator = (
+            concurrency.ConcurrentGatheringIterator()
+        )
+        for i in (0, 1, 2, 4):
+            iterator.insert(i, i * 10)
+        self.assertEqual(iterator.next_n(0, 9), [0, 10, 20])
+        iterator.insert(3, 30)
+        self.assertEqual(iterator.next_n(3, 9), [30, 40])
+        self.assertEqual(iterator.next_n(10, 9), [])
+
+    def test_next_n_none_values(self) -> None:
+        iterator: concurrency.ConcurrentGatheringIterator = (
+            concurrency.ConcurrentGatheringIterator()
+        )
+        iterator.insert(0, None)
+        iterator.insert(1, None)
+        self.assertEqual(iterator.next_n(0, 5), [None, None])
+
+    def test_next_n_blocks_for_first(self) -> None:
+        iterator: concurrency.ConcurrentGatheringIterator = (
+            concurrency.ConcurrentGatheringIterator()
+        )
+
+        def worker() -> None:
+            time.sleep(0.1)
+            iterator.insert(0, 10)
+            iterator.insert(1, 11)
+
+        t: threading.Thread = threading.Thread(target=worker)
+        t.start()
+        values = iterator.next_n(0, 5)
+        t.join()
+        self.assertEqual(values[0], 10)
+        self.assertLessEqual(len(values), 2)
+
+    def test_next_n_threads(self) -> None:
+        iterator: concurrency.ConcurrentGatheringIterator = (
+            concurrency.ConcurrentGatheringIterator()
+        )
+        count = 1000
+        gathered: list[object] = []
+
+        def producer(offset: int) -> None:
+            for i in range(count // 2):
+                iterator.insert(i * 2 + offset, i * 2 + offset)
+
+        def reader() -> None:
+            key = 0
+            while key < count:
+                values = iterator.next_n(key, count - 1)
+                gathered.extend(values)
+                key += len(values)
+
+        run_each_concurrently(
+            [lambda: producer(0), lambda: producer(1), reader]
+        )
+        self.assertEqual(gathered, list(range(count)))
+
 
 class TestAtomicReference(unittest.TestCase):
     def test_set_get(self) -> None:
@@ -1734,5 +2475,520 @@ class TestAtomicReference(unittest.TestCase):
             concurrency.AtomicReference(x, y)  # pyre-ignore[19]
 
 
+class TestAtomicReferenceArray(unittest.TestCase):
+    def test_create(self) -> None:
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(4)
+        self.assertEqual(len(arr), 4)
+        for i in range(4):
+            self.assertIsNone(arr.get(i))
+        with self.assertRaises(ValueError):
+            concurrency.AtomicReferenceArray(-1)
+
+    def test_initial(self) -> None:
+        sentinel: str = "empty"
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(
+            3, sentinel
+        )
+        self.assertEqual(arr.to_list(), [sentinel, sentinel, sentinel])
+
+    def test_set_get(self) -> None:
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(4)
+        arr.set(1, "value")
+        self.assertEqual(arr.get(1), "value")
+        self.assertIsNone(arr.get(0))
+        arr[2] = "other"
+        self.assertEqual(arr[2], "other")
+
+    def test_index_errors(self) -> None:
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(2)
+        with self.assertRaises(IndexError):
+            arr.get(2)
+        with self.assertRaises(IndexError):
+            arr.set(-1, "value")
+        with self.assertRaises(IndexError):
+            arr.exchange(5, "value")
+        with self.assertRaises(IndexError):
+            arr.compare_exchange(5, None, "value")
+
+    def test_exchange(self) -> None:
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(2)
+        arr.set(0, "old_value")
+        exchanged: str | None = arr.exchange(0, "new_value")
+        self.assertEqual(exchanged, "old_value")
+        self.assertEqual(arr.get(0), "new_value")
+        self.assertIsNone(arr.get(1))
+
+    def test_compare_exchange(self) -> None:
+        ov: str = "old_value"
+        mv: str = "middle_value"
+        nv: str = "new_value"
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(2)
+        arr.set(1, ov)
+        arr.set(1, mv)
+        self.assertFalse(arr.compare_exchange(1, ov, nv))
+        self.assertIs(arr.get(1), mv)
+        self.assertTrue(arr.compare_exchange(1, mv, nv))
+        self.assertIs(arr.get(1), nv)
+
+    def test_concurrency_set(self) -> None:
+        arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(4)
+
+        def set_slot(value: int) -> None:
+            arr.set(value % 4, value)
+
+        run_each_concurrently([lambda i=i: set_slot(i) for i in range(20)])
+
+        for i in range(4):
+            self.assertIn(arr.get(i), range(20))
+
+    def test_gc_acyclic(self) -> None:
+        class Foo:
+            pass
+
+        for exchange in True, False:
+            arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(2)
+            obj: Foo = Foo()
+            weak_obj: weakref.ref[Foo] = weakref.ref(obj)
+            arr.set(0, obj)
+            del obj
+            if exchange:
+                arr.exchange(0, None)
+            else:
+                arr.set(0, None)
+            gc.collect()
+            self.assertIsNone(weak_obj())
+
+    def test_gc_cyclic(self) -> None:
+        for delete_arr in True, False:
+            arr: concurrency.AtomicReferenceArray = concurrency.AtomicReferenceArray(2)
+            obj1: concurrency.AtomicReference = concurrency.AtomicReference(None)
+            obj2: concurrency.AtomicReference = concurrency.AtomicReference(None)
+            obj1.set(obj2)
+            obj2.set(obj1)
+            arr.set(0, obj1)
+            del obj1
+            del obj2
+            gc.collect()
+            self.assertIsNotNone(arr.get(0))
+
+            if delete_arr:
+                del arr
+            else:
+                arr.set(0, None)
+            gc.collect()
+            self.assertTrue(gc.garbage == [])
+
+
+class TestAtomicStampedReference(unittest.TestCase):
+    def test_smoke(self) -> None:
+        ref: concurrency.AtomicStampedReference = (
+            concurrency.AtomicStampedReference()
+        )
+        self.assertEqual(ref.get(), (None, 0))
+        ref.set("value", 3)
+        self.assertEqual(ref.get(), ("value", 3))
+        self.assertEqual(ref.get_reference(), "value")
+        self.assertEqual(ref.get_stamp(), 3)
+
+    def test_compare_exchange(self) -> None:
+        ov: str = "old_value"
+        nv: str = "new_value"
+        ref: concurrency.AtomicStampedReference = (
+            concurrency.AtomicStampedReference(ov, 1)
+        )
+        self.assertFalse(ref.compare_exchange(ov, nv, 0))
+        self.assertFalse(ref.compare_exchange(nv, nv, 1))
+        self.assertEqual(ref.get(), (ov, 1))
+        self.assertTrue(ref.compare_exchange(ov, nv, 1))
+        self.assertEqual(ref.get(), (nv, 2))
+        self.assertTrue(ref.compare_exchange(nv, ov, 2, 10))
+        self.assertEqual(ref.get(), (ov, 10))
+
+    def test_aba(self) -> None:
+        a: str = "a"
+        b: str = "b"
+        ref: concurrency.AtomicStampedReference = (
+            concurrency.AtomicStampedReference(a, 0)
+        )
+        # Another thread swaps a -> b -> a; the stamp has moved on so a CAS
+        # against the stale (a, 0) observation must fail.
+        self.assertTrue(ref.compare_exchange(a, b, 0))
+        self.assertTrue(ref.compare_exchange(b, a, 1))
+        self.assertFalse(ref.compare_exchange(a, b, 0))
+        self.assertEqual(ref.get(), (a, 2))
+
+    def test_threads(self) -> None:
+        ref: concurrency.AtomicStampedReference = (
+            concurrency.AtomicStampedReference(0, 0)
+        )
+
+        def worker(n: int) -> None:
+            for _ in range(n):
+                while True:
+                    value, stamp = ref.get()
+                    if ref.compare_exchange(value, value + 1, stamp):  # pyre-ignore
+                        break
+
+        run_concurrently(worker, 10, args=(100,))
+        self.assertEqual(ref.get(), (1000, 1000))
+
+    def test_gc(self) -> None:
+        class Foo:
+            pass
+
+        obj: Foo = Foo()
+        weak_obj: weakref.ref[Foo] = weakref.ref(obj)
+        ref: concurrency.AtomicStampedReference = (
+            concurrency.AtomicStampedReference(obj, 0)
+        )
+        self.assertTrue(ref.compare_exchange(obj, None, 0))
+        del obj
+        gc.collect()
+        self.assertIsNone(weak_obj())
+        del ref
+        gc.collect()
+        self.assertTrue(gc.garbage == [])
+
+
+class TestConcurrentSet(unittest.TestCase):
+    def test_smoke(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet()
+        cst.add(1)
+        self.assertTrue(1 in cst)
+        self.assertFalse(2 in cst)
+        self.assertEqual(len(cst), 1)
+        cst.discard(1)
+        self.assertFalse(1 in cst)
+        cst.discard(1)  # no error on missing
+        with self.assertRaisesRegex(KeyError, "1"):
+            cst.remove(1)
+
+    def test_constructor_iterable(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(100))
+        self.assertEqual(len(cst), 100)
+        self.assertEqual(cst.as_set(), set(range(100)))
+
+    def test_big(self) -> None:
+        cst: concurrency.ConcurrentSet[object] = concurrency.ConcurrentSet()
+        for i in range(10000):
+            cst.add(i)
+        for i in range(10000):
+            self.assertTrue(i in cst)
+        for i in range(10000):
+            cst.add(str(i))
+        self.assertEqual(len(cst), 20000)
+
+    def test_growable(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(growable=True)
+        for i in range(5000):
+            cst.add(i)
+        self.assertEqual(len(cst), 5000)
+        for i in range(5000):
+            self.assertTrue(i in cst)
+        self.assertEqual(cst.as_set(), set(range(5000)))
+
+    def test_threads(self) -> None:
+        cst: concurrency.ConcurrentSet[object] = concurrency.ConcurrentSet(
+            initial_capacity=37, growable=True
+        )
+
+        def win() -> None:
+            for i in range(1000):
+                cst.add(i)
+
+        def wstr() -> None:
+            for i in range(1000):
+                cst.add(str(i))
+
+        def wdel() -> None:
+            for i in range(1000):
+                cst.add(-(i + 1))
+            for i in range(1000):
+                cst.discard(-(i + 1))
+
+        run_each_concurrently([win, wstr, wdel, win, wstr, wdel])
+        for i in range(1000):
+            self.assertTrue(i in cst)
+            self.assertTrue(str(i) in cst)
+        self.assertFalse(-10 in cst)
+
+    def test_update(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(10))
+        other: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(5, 15))
+        cst.update(other)
+        self.assertEqual(cst.as_set(), set(range(15)))
+        cst.update([20, 21])
+        self.assertEqual(len(cst), 17)
+
+    def test_union(self) -> None:
+        left: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(10))
+        right: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(5, 15))
+        merged = left.union(right)
+        self.assertEqual(merged.as_set(), set(range(15)))
+        # The inputs are untouched.
+        self.assertEqual(len(left), 10)
+        self.assertEqual(len(right), 10)
+        self.assertEqual(left.union([100]).as_set(), set(range(10)) | {100})
+
+    def test_intersection(self) -> None:
+        left: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(10))
+        right: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(5, 15))
+        self.assertEqual(left.intersection(right).as_set(), set(range(5, 10)))
+        self.assertEqual(left.intersection([3, 99]).as_set(), {3})
+        self.assertEqual(len(left.intersection([])), 0)
+
+    def test_iter(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet(range(100))
+        self.assertEqual(sorted(cst), list(range(100)))
+
+    def test_eq_repr(self) -> None:
+        cst: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet([1, 2, 3])
+        self.assertEqual(cst, concurrency.ConcurrentSet([3, 2, 1]))
+        self.assertNotEqual(cst, concurrency.ConcurrentSet([1, 2]))
+        self.assertEqual(cst, {1, 2, 3})
+        empty: concurrency.ConcurrentSet[int] = concurrency.ConcurrentSet()
+        self.assertEqual(repr(empty), "ConcurrentSet(set())")
+
+    def test_dundar(self) -> None:
+        class Hasher:
+            def __init__(self, value: int | None) -> None:
+                self._value: int | None = value
+
+            def __hash__(self) -> int:
+                if self._value is None:
+                    raise RuntimeError("Invalid Hasher")
+                return self._value
+
+        cst: concurrency.ConcurrentSet[object] = concurrency.ConcurrentSet()
+        illegal: Hasher = Hasher(None)
+        with self.assertRaisesRegex(RuntimeError, "Invalid Hasher"):
+            cst.add(illegal)
+        with self.assertRaises(RuntimeError):
+            illegal in cst
+        legal: Hasher = Hasher(-1)
+        cst.add(legal)
+        self.assertTrue(legal in cst)
+        cst.remove(legal)
+        self.assertFalse(legal in cst)
+
+
+class TestParallelMap(unittest.TestCase):
+    def test_smoke(self) -> None:
+        results = concurrency.parallel_map(lambda x: x * 2, range(1000))
+        self.assertEqual(results, [x * 2 for x in range(1000)])
+
+    def test_empty(self) -> None:
+        self.assertEqual(concurrency.parallel_map(lambda x: x, []), [])
+
+    def test_single_worker(self) -> None:
+        results = concurrency.parallel_map(lambda x: x + 1, range(100), workers=1)
+        self.assertEqual(results, list(range(1, 101)))
+
+    def test_order_preserved_with_uneven_cost(self) -> None:
+        def slow_evens(x: int) -> int:
+            if x % 2 == 0:
+                time.sleep(0.001)
+            return -x
+
+        results = concurrency.parallel_map(
+            slow_evens, range(64), workers=4, chunk_size=2
+        )
+        self.assertEqual(results, [-x for x in range(64)])
+
+    def test_uses_many_threads(self) -> None:
+        seen: concurrency.ConcurrentSet[object] = concurrency.ConcurrentSet()
+
+        def record(x: int) -> int:
+            seen.add(threading.get_ident())
+            time.sleep(0.001)
+            return x
+
+        concurrency.parallel_map(record, range(64), workers=4, chunk_size=4)
+        self.assertGreater(len(seen), 1)
+
+    def test_exception_propagates(self) -> None:
+        def boom(x: int) -> int:
+            if x == 37:
+                raise ValueError("boom")
+            return x
+
+        with self.assertRaisesRegex(ValueError, "boom"):
+            concurrency.parallel_map(boom, range(100), workers=4)
+
+
+class TestMapReduce(unittest.TestCase):
+    def test_sum_of_squares(self) -> None:
+        result = concurrency.map_reduce(
+            lambda x: x * x, lambda a, b: a + b, range(1000)
+        )
+        self.assertEqual(result, sum(x * x for x in range(1000)))
+
+    def test_initial(self) -> None:
+        result = concurrency.map_reduce(
+            lambda x: x, lambda a, b: a + b, range(10), initial=100
+        )
+        self.assertEqual(result, 145)
+
+    def test_empty_with_initial(self) -> None:
+        result = concurrency.map_reduce(
+            lambda x: x, lambda a, b: a + b, [], initial=7
+        )
+        self.assertEqual(result, 7)
+
+    def test_empty_without_initial(self) -> None:
+        with self.assertRaises(TypeError):
+            concurrency.map_reduce(lambda x: x, lambda a, b: a + b, [])
+
+    def test_max(self) -> None:
+        values: list[int] = [((x * 7919) % 104729) for x in range(5000)]
+        result = concurrency.map_reduce(lambda x: x, max, values, workers=8)
+        self.assertEqual(result, max(values))
+
+    def test_exception_propagates(self) -> None:
+        with self.assertRaisesRegex(RuntimeError, "reduce"):
+            concurrency.map_reduce(
+                lambda x: x,
+                lambda a, b: (_ for _ in ()).throw(RuntimeError("reduce")),
+                range(100),
+            )
+
+
+class TestSharedMemoryDict(unittest.TestCase):
+    def setUp(self) -> None:
+        self._name: str = f"ftu-test-{os.getpid()}-{uuid.uuid4().hex[:8]}"
+        self._dict: concurrency.SharedMemoryDict = concurrency.SharedMemoryDict(
+            self._name, create=True, capacity=64, data_size=65536
+        )
+
+    def tearDown(self) -> None:
+        self._dict.unlink()
+        self._dict.close()
+
+    def test_smoke(self) -> None:
+        shd = self._dict
+        shd["a"] = b"bytes"
+        shd[b"b"] = "text"
+        shd[7] = -42
+        shd["pi"] = 3.5
+        self.assertEqual(shd["a"], b"bytes")
+        self.assertEqual(shd[b"b"], "text")
+        self.assertEqual(shd[7], -42)
+        self.assertEqual(shd["pi"], 3.5)
+        self.assertEqual(len(shd), 4)
+        self.assertTrue("a" in shd)
+        self.assertFalse("missing" in shd)
+        with self.assertRaises(KeyError):
+            shd["missing"]
+        self.assertEqual(shd.get("missing"), None)
+        self.assertEqual(shd.get("missing", "dflt"), "dflt")
+
+    def test_delete_and_overwrite(self) -> None:
+        shd = self._dict
+        shd["key"] = 1
+        shd["key"] = 2
+        self.assertEqual(shd["key"], 2)
+        self.assertEqual(len(shd), 1)
+        del shd["key"]
+        self.assertFalse("key" in shd)
+        self.assertEqual(len(shd), 0)
+        with self.assertRaises(KeyError):
+            del shd["key"]
+        shd["key"] = 3
+        self.assertEqual(shd["key"], 3)
+        self.assertEqual(len(shd), 1)
+
+    def test_flat_types_only(self) -> None:
+        shd = self._dict
+        with self.assertRaises(TypeError):
+            shd[1.5] = 1  # pyre-ignore[6]
+        with self.assertRaises(TypeError):
+            shd["key"] = [1, 2]  # pyre-ignore[6]
+        with self.assertRaises(OverflowError):
+            shd["key"] = 1 << 80
+
+    def test_keys_as_dict(self) -> None:
+        shd = self._dict
+        expected: dict[object, object] = {}
+        for i in range(32):
+            shd[i] = str(i)
+            expected[i] = str(i)
+        self.assertEqual(sorted(shd.keys()), sorted(expected))  # pyre-ignore[6]
+        self.assertEqual(shd.as_dict(), expected)
+
+    def test_reader_attach(self) -> None:
+        self._dict["shared"] = b"payload"
+        reader = concurrency.SharedMemoryDict(self._name)
+        try:
+            self.assertEqual(reader["shared"], b"payload")
+            self.assertEqual(len(reader), 1)
+            with self.assertRaisesRegex(RuntimeError, "read-only"):
+                reader["nope"] = 1
+        finally:
+            reader.close()
+
+    def test_subprocess_read(self) -> None:
+        self._dict["proc"] = 12345
+        code = (
+            "from ft_utils.concurrency import SharedMemoryDict\n"
+            f"shd = SharedMemoryDict({self._name!r})\n"
+            "print(shd['proc'])\n"
+            "shd.close()\n"
+        )
+        output = subprocess.check_output([sys.executable, "-c", code], text=True)
+        self.assertEqual(output.strip(), "12345")
+
+    def test_capacity_limits(self) -> None:
+        name = f"{self._name}-small"
+        small = concurrency.SharedMemoryDict(
+            name, create=True, capacity=4, data_size=4096
+        )
+        try:
+            with self.assertRaisesRegex(RuntimeError, "full"):
+                for i in range(4096):
+                    small[i] = i
+        finally:
+            small.unlink()
+            small.close()
+
+    def test_closed(self) -> None:
+        name = f"{self._name}-closed"
+        shd = concurrency.SharedMemoryDict(name, create=True)
+        shd.unlink()
+        shd.close()
+        with self.assertRaisesRegex(RuntimeError, "closed"):
+            shd["key"]
+        with self.assertRaisesRegex(RuntimeError, "closed"):
+            shd["key"] = 1
+
+    def test_open_missing(self) -> None:
+        with self.assertRaises(OSError):
+            concurrency.SharedMemoryDict(f"{self._name}-missing")
+
+
+class TestRegisterReferenceBatch(unittest.TestCase):
+    def test_smoke(self) -> None:
+        objs: list[object] = [object() for _ in range(100)]
+        self.assertIsNone(concurrency.register_reference_batch(objs))
+        self.assertIsNone(concurrency.register_reference_batch(tuple(objs)))
+        self.assertIsNone(concurrency.register_reference_batch(iter(objs)))
+        self.assertIsNone(concurrency.register_reference_batch([]))
+
+    def test_not_iterable(self) -> None:
+        with self.assertRaises(TypeError):
+            concurrency.register_reference_batch(42)  # pyre-ignore[6]
+
+    def test_bulk_load_then_read(self) -> None:
+        values: list[object] = [object() for _ in range(1000)]
+        concurrency.register_reference_batch(values)
+        dct: concurrency.ConcurrentDict = concurrency.ConcurrentDict()
+        dct.update_batch([(i, value) for i, value in enumerate(values)])
+        deq: concurrency.ConcurrentDeque = concurrency.ConcurrentDeque()
+        deq.extend(values)
+        self.assertEqual(len(dct.keys()), 1000)
+        self.assertEqual(len(deq), 1000)
+        self.assertIs(dct[0], values[0])
+        self.assertIs(deq[999], values[999])
+
+
 if __name__ == "__main__":
     unittest.main()
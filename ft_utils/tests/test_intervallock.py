@@ -205,6 +205,70 @@ class TestIntervalLock(unittest.TestCase):
         )
 
 
+class TestIntervalLockStats(unittest.TestCase):
+    def test_stats_counters(self) -> None:
+        lock: IntervalLock = IntervalLock(interval=0.01)
+        lock.lock()
+        lock.cede()
+        lock.unlock()
+        stats = lock.stats()
+        self.assertEqual(stats["acquisitions"], 2)
+        self.assertEqual(stats["cedes"], 1)
+        self.assertGreaterEqual(stats["average_wait"], 0.0)
+        self.assertGreaterEqual(stats["average_hold"], 0.0)
+        self.assertAlmostEqual(stats["interval"], 0.01, places=3)
+
+    def test_adaptive_interval_stays_bounded(self) -> None:
+        lock: IntervalLock = IntervalLock(interval=0.01, adaptive=True)
+        for _ in range(100):
+            lock.lock()
+            lock.unlock()
+        interval = lock.stats()["interval"]
+        self.assertGreaterEqual(interval, 0.01 / 8)
+        self.assertLessEqual(interval, 0.01 * 8)
+
+    def test_adaptive_interval_grows_when_uncontended(self) -> None:
+        lock: IntervalLock = IntervalLock(interval=0.01, adaptive=True)
+        for _ in range(100):
+            lock.lock()
+            lock.unlock()
+        # With no waiters the effective interval climbs to the ceiling.
+        self.assertGreater(lock.stats()["interval"], 0.01)
+
+    def test_adaptive_interval_shrinks_under_contention(self) -> None:
+        lock: IntervalLock = IntervalLock(interval=0.01, adaptive=True)
+        stop: threading.Event = threading.Event()
+
+        def contender() -> None:
+            while not stop.is_set():
+                lock.lock()
+                lock.unlock()
+
+        threads: list[threading.Thread] = [
+            threading.Thread(target=contender) for _ in range(4)
+        ]
+        for thread in threads:
+            thread.start()
+        deadline: float = time.time() + 5.0
+        try:
+            while time.time() < deadline:
+                if lock.stats()["interval"] < 0.01:
+                    break
+                time.sleep(0.01)
+        finally:
+            stop.set()
+            for thread in threads:
+                thread.join()
+        self.assertLess(lock.stats()["interval"], 0.01)
+
+    def test_fixed_interval_does_not_adapt(self) -> None:
+        lock: IntervalLock = IntervalLock(interval=0.01)
+        for _ in range(50):
+            lock.lock()
+            lock.unlock()
+        self.assertAlmostEqual(lock.stats()["interval"], 0.01, places=6)
+
+
 class TestIntervalLockSignals(unittest.TestCase):
     def test_interrupt_handling(self) -> None:
         def acquire(lock: object) -> None:
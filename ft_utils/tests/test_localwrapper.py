@@ -4,6 +4,8 @@
 
 import asyncio
 import gc
+import sys
+import threading
 import traceback
 import types
 import unittest
@@ -11,7 +13,8 @@ from collections.abc import Iterator
 from contextlib import ContextDecorator
 from typing import Any
 
-from ft_utils.local import LocalWrapper
+import ft_utils
+from ft_utils.local import localize, LocalWrapper
 
 
 class TestLocalWrapperSmokes(unittest.TestCase):
@@ -112,6 +115,55 @@ class TestLocalWrapperSmokes(unittest.TestCase):
         gc.collect()
         self.assertTrue(gc.garbage == [])
 
+    def test_method_cache(self) -> None:
+        d: dict[int, int] = {1: 2}
+        wrapper: LocalWrapper = LocalWrapper(d)
+        for _ in range(100):
+            self.assertEqual(wrapper.get(1), 2)
+            self.assertIsNone(wrapper.get(3))
+        d[3] = 4
+        self.assertEqual(wrapper.get(3), 4)
+
+    def test_method_cache_type_change(self) -> None:
+        class Thing:
+            __slots__ = ()
+
+            def value(self) -> int:
+                return 1
+
+        wrapper: LocalWrapper = LocalWrapper(Thing())
+        self.assertEqual(wrapper.value(), 1)
+        self.assertEqual(wrapper.value(), 1)
+        Thing.value = lambda self: 2  # pyre-ignore[41]
+        self.assertEqual(wrapper.value(), 2)
+
+    def test_method_cache_instance_shadow(self) -> None:
+        class Thing:
+            def value(self) -> int:
+                return 1
+
+        thing: Thing = Thing()
+        wrapper: LocalWrapper = LocalWrapper(thing)
+        self.assertEqual(wrapper.value(), 1)
+        thing.value = lambda: 3  # pyre-ignore[8]
+        self.assertEqual(wrapper.value(), 3)
+
+    def test_property_not_cached(self) -> None:
+        class Counter:
+            __slots__ = ("_count",)
+
+            def __init__(self) -> None:
+                self._count = 0
+
+            @property
+            def count(self) -> int:
+                self._count += 1
+                return self._count
+
+        wrapper: LocalWrapper = LocalWrapper(Counter())
+        self.assertEqual(wrapper.count, 1)
+        self.assertEqual(wrapper.count, 2)
+
     def test_repr(self) -> None:
         obj_repr: str = repr(self.obj)
         wrapper_repr: str = repr(self.wrapper)
@@ -1083,5 +1135,74 @@ class TestLocalWrapperContext(unittest.TestCase):
         self.assertTrue(ctx_mgr.exit_called)
 
 
+class TestLocalize(unittest.TestCase):
+    def test_returns_wrappers(self) -> None:
+        obj_a: list[int] = [1, 2, 3]
+        obj_b: dict[str, int] = {"key": 1}
+        wrapper_a, wrapper_b = localize(obj_a, obj_b)
+        self.assertIsInstance(wrapper_a, LocalWrapper)
+        self.assertIsInstance(wrapper_b, LocalWrapper)
+        self.assertIs(wrapper_a.wrapped, obj_a)
+        self.assertIs(wrapper_b.wrapped, obj_b)
+
+    def test_empty(self) -> None:
+        self.assertEqual(localize(), ())
+
+    def test_wrapper_passthrough(self) -> None:
+        wrapper: LocalWrapper = LocalWrapper([1, 2, 3])
+        (result,) = localize(wrapper)
+        self.assertIs(result, wrapper)
+
+    def test_wrapper_usable(self) -> None:
+        obj: list[int] = []
+        (wrapper,) = localize(obj)
+        wrapper.append(1)
+        self.assertEqual(obj, [1])
+        self.assertEqual(wrapper[0], 1)
+
+    def test_many_threads(self) -> None:
+        obj: list[int] = [1, 2, 3]
+
+        def worker() -> None:
+            for _ in range(100):
+                (wrapper,) = localize(obj)
+                self.assertIs(wrapper.wrapped, obj)
+
+        threads = [threading.Thread(target=worker) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+
+@unittest.skipIf(sys.version_info < (3, 13), "Requires Python 3.13 or later")
+class TestLocalizeCache(unittest.TestCase):
+    """The per-thread wrapper cache needs the wvls destructor layer which is
+    only available on free threaded builds with experimental support on."""
+
+    def setUp(self) -> None:
+        ft_utils.ENABLE_EXPERIMENTAL = True
+
+    def test_reuses_cached_wrapper(self) -> None:
+        obj: list[int] = [1, 2, 3]
+        (first,) = localize(obj)
+        (second,) = localize(obj)
+        self.assertIs(first, second)
+
+    def test_cache_is_per_thread(self) -> None:
+        obj: list[int] = [1, 2, 3]
+        (mine,) = localize(obj)
+        theirs: list[LocalWrapper] = []
+
+        def worker() -> None:
+            theirs.append(localize(obj)[0])
+
+        thread = threading.Thread(target=worker)
+        thread.start()
+        thread.join()
+        self.assertIsNot(theirs[0], mine)
+        self.assertIs(theirs[0].wrapped, obj)
+
+
 if __name__ == "__main__":
     unittest.main()
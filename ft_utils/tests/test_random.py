@@ -0,0 +1,111 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+import unittest
+
+from ft_utils import random as ft_random
+from ft_utils.threading_test_utils import run_concurrently
+
+
+class TestRandom(unittest.TestCase):
+    def test_random_range(self) -> None:
+        for _ in range(1000):
+            value = ft_random.random()
+            self.assertGreaterEqual(value, 0.0)
+            self.assertLess(value, 1.0)
+
+    def test_random_varies(self) -> None:
+        values = {ft_random.random() for _ in range(100)}
+        self.assertGreater(len(values), 1)
+
+    def test_randint_range(self) -> None:
+        for _ in range(1000):
+            value = ft_random.randint(1, 100)
+            self.assertGreaterEqual(value, 1)
+            self.assertLessEqual(value, 100)
+
+    def test_randint_degenerate(self) -> None:
+        self.assertEqual(ft_random.randint(7, 7), 7)
+        self.assertEqual(ft_random.randint(-3, -3), -3)
+
+    def test_randint_negative_range(self) -> None:
+        for _ in range(1000):
+            value = ft_random.randint(-100, -1)
+            self.assertGreaterEqual(value, -100)
+            self.assertLessEqual(value, -1)
+
+    def test_randint_covers_range(self) -> None:
+        seen = {ft_random.randint(0, 3) for _ in range(1000)}
+        self.assertEqual(seen, {0, 1, 2, 3})
+
+    def test_randint_empty_range(self) -> None:
+        with self.assertRaises(ValueError):
+            ft_random.randint(10, 1)
+
+    def test_randint_arg_errors(self) -> None:
+        with self.assertRaises(TypeError):
+            ft_random.randint(1)  # pyre-ignore[19]
+        with self.assertRaises(TypeError):
+            ft_random.randint("a", "b")  # pyre-ignore[6]
+
+    def test_choice(self) -> None:
+        seq = ["a", "b", "c"]
+        for _ in range(100):
+            self.assertIn(ft_random.choice(seq), seq)
+
+    def test_choice_empty(self) -> None:
+        with self.assertRaises(IndexError):
+            ft_random.choice([])
+
+    def test_rand_ints(self) -> None:
+        values = ft_random.rand_ints(1000)
+        self.assertEqual(len(values), 1000)
+        for value in values:
+            self.assertGreaterEqual(value, 0)
+            self.assertLess(value, 2**64)
+        self.assertGreater(len(set(values)), 900)
+
+    def test_rand_ints_empty(self) -> None:
+        self.assertEqual(ft_random.rand_ints(0), [])
+        with self.assertRaises(ValueError):
+            ft_random.rand_ints(-1)
+
+    def test_seed_deterministic(self) -> None:
+        ft_random.seed(12345)
+        first = ft_random.rand_ints(10)
+        ft_random.seed(12345)
+        second = ft_random.rand_ints(10)
+        self.assertEqual(first, second)
+        ft_random.seed(54321)
+        third = ft_random.rand_ints(10)
+        self.assertNotEqual(first, third)
+
+    def test_threads_have_independent_streams(self) -> None:
+        results: list[list[int]] = []
+
+        def worker() -> None:
+            results.append(ft_random.rand_ints(100))
+
+        run_concurrently(worker, 4)
+        self.assertEqual(len(results), 4)
+        for i in range(4):
+            for j in range(i + 1, 4):
+                self.assertNotEqual(results[i], results[j])
+
+    def test_seed_is_thread_local(self) -> None:
+        ft_random.seed(999)
+        other: list[list[int]] = []
+
+        def worker() -> None:
+            other.append(ft_random.rand_ints(10))
+
+        run_concurrently(worker, 1)
+        mine = ft_random.rand_ints(10)
+        ft_random.seed(999)
+        self.assertEqual(ft_random.rand_ints(10), mine)
+        self.assertNotEqual(other[0], mine)
+
+
+if __name__ == "__main__":
+    unittest.main()
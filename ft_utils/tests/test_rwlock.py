@@ -338,6 +338,77 @@ class TestRWLock(unittest.TestCase):
         self.assertTrue(unlocked)
 
 
+class TestStripedRWLock(unittest.TestCase):
+    def test_simple_striped(self) -> None:
+        lock: RWLock = RWLock(striped=True)
+        lock.lock_read()
+        lock.unlock_read()
+        lock.lock_write()
+        lock.unlock_write()
+        lock.lock_read()
+        lock.unlock_read()
+
+    def test_readers_sums_stripes(self) -> None:
+        lock: RWLock = RWLock(striped=True)
+        count: AtomicInt64 = AtomicInt64()
+        done: AtomicFlag = AtomicFlag(False)
+
+        def read_wait() -> None:
+            # pyrefly: ignore [bad-context-manager]
+            with RWReadContext(lock):
+                count.incr()
+                while not done:
+                    time.sleep(0.01)
+
+        threads: list[threading.Thread] = [
+            threading.Thread(target=read_wait) for _ in range(10)
+        ]
+        for t in threads:
+            t.start()
+        while count < 10:
+            time.sleep(0.01)
+        readers: int = lock.readers()
+        done.set(True)
+        for t in threads:
+            t.join()
+
+        self.assertEqual(readers, 10)
+        self.assertEqual(lock.readers(), 0)
+
+    def test_writer_excludes_striped_readers(self) -> None:
+        lock: RWLock = RWLock(striped=True)
+        value: AtomicInt64 = AtomicInt64()
+        shadow: AtomicInt64 = AtomicInt64()
+        ok: AtomicFlag = AtomicFlag(True)
+
+        def reader() -> None:
+            for _ in range(200):
+                lock.lock_read()
+                if int(value) != int(shadow):
+                    ok.set(False)
+                lock.unlock_read()
+
+        def writer() -> None:
+            for _ in range(50):
+                lock.lock_write()
+                value.incr()
+                time.sleep(0.0001)
+                shadow.incr()
+                lock.unlock_write()
+
+        threads: list[threading.Thread] = [
+            threading.Thread(target=reader) for _ in range(8)
+        ] + [threading.Thread(target=writer) for _ in range(2)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        self.assertTrue(ok)
+        self.assertEqual(int(value), 100)
+        self.assertEqual(lock.readers(), 0)
+
+
 class TestRWLockSignals(unittest.TestCase):
     def test_interrupt_handling_write(self) -> None:
         def acquire(lock: object) -> None:
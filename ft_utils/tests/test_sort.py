@@ -0,0 +1,109 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+
+# pyre-strict
+
+import random
+import unittest
+
+from ft_utils import parallel_sort
+
+
+class Record:
+    """Orders by key only so stability is observable through seq."""
+
+    def __init__(self, key: int, seq: int) -> None:
+        self.key = key
+        self.seq = seq
+
+    def __lt__(self, other: "Record") -> bool:
+        return self.key < other.key
+
+
+class Exploder:
+    def __init__(self, value: int, fuse: int) -> None:
+        self.value = value
+        self.fuse = fuse
+
+    def __lt__(self, other: "Exploder") -> bool:
+        if self.value == self.fuse or other.value == other.fuse:
+            raise ZeroDivisionError("comparator blew up")
+        return self.value < other.value
+
+
+class TestParallelSort(unittest.TestCase):
+    def test_smoke(self) -> None:
+        values: list[int] = [random.randint(0, 9999) for _ in range(100000)]
+        expected: list[int] = sorted(values)
+        parallel_sort(values, threads=4)
+        self.assertEqual(values, expected)
+
+    def test_empty_and_small(self) -> None:
+        values: list[int] = []
+        parallel_sort(values)
+        self.assertEqual(values, [])
+        values = [3, 1, 2]
+        parallel_sort(values)
+        self.assertEqual(values, [1, 2, 3])
+
+    def test_single_thread(self) -> None:
+        values: list[int] = [random.randint(0, 999) for _ in range(5000)]
+        expected: list[int] = sorted(values)
+        parallel_sort(values, threads=1)
+        self.assertEqual(values, expected)
+
+    def test_presorted_and_reversed(self) -> None:
+        values: list[int] = list(range(50000))
+        parallel_sort(values, threads=8)
+        self.assertEqual(values, list(range(50000)))
+        values = list(range(50000, 0, -1))
+        parallel_sort(values, threads=8)
+        self.assertEqual(values, sorted(values))
+
+    def test_strings(self) -> None:
+        values: list[str] = [f"key-{random.randint(0, 9999):05}" for _ in range(20000)]
+        expected: list[str] = sorted(values)
+        parallel_sort(values, threads=4)
+        self.assertEqual(values, expected)
+
+    def test_stable(self) -> None:
+        records: list[Record] = [
+            Record(random.randint(0, 9), seq) for seq in range(20000)
+        ]
+        parallel_sort(records, threads=4)
+        for left, right in zip(records, records[1:]):
+            self.assertLessEqual(left.key, right.key)
+            if left.key == right.key:
+                self.assertLess(left.seq, right.seq)
+
+    def test_comparator_error_propagates(self) -> None:
+        fuse: int = 3000
+        values: list[Exploder] = [Exploder(value, fuse) for value in range(8192)]
+        random.shuffle(values)
+        with self.assertRaises(ZeroDivisionError):
+            parallel_sort(values, threads=4)
+
+    def test_not_a_list(self) -> None:
+        with self.assertRaises(TypeError):
+            # pyre-ignore[6]: Intentional bad argument.
+            parallel_sort((3, 2, 1))
+
+    def test_modified_during_sort(self) -> None:
+        values: list[object] = []
+
+        class Meddler:
+            def __init__(self, value: int) -> None:
+                self.value = value
+
+            def __lt__(self, other: "Meddler") -> bool:
+                if len(values) == 8192:
+                    values.append(None)
+                return self.value < other.value
+
+        values.extend(Meddler(value) for value in range(8192))
+        random.shuffle(values)  # pyre-ignore[6]
+        with self.assertRaises(ValueError):
+            parallel_sort(values, threads=4)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -9,6 +9,9 @@ import unittest
 
 import ft_utils
 from ft_utils._test_weave import (  # @manual
+    arena_exercise,
+    arena_large,
+    arena_reset_reuses,
     get_destructor_called_1,
     get_destructor_called_2,
     register_destructor_1,
@@ -131,5 +134,38 @@ class TestTLSManagement(unittest.TestCase):
         self.assertEqual(get_destructor_called_1(), num_threads)
 
 
+@unittest.skipIf(sys.version_info < (3, 13), "Requires Python 3.13 or later")
+class TestArena(unittest.TestCase):
+    def setUp(self) -> None:
+        ft_utils.ENABLE_EXPERIMENTAL = True
+
+    def test_arena_alloc(self) -> None:
+        arena_exercise()
+
+    def test_arena_alloc_threads(self) -> None:
+        errors: list[BaseException] = []
+
+        def thread_func() -> None:
+            try:
+                arena_exercise()
+            except BaseException as error:  # noqa: B902
+                errors.append(error)
+
+        threads: list[threading.Thread] = [
+            threading.Thread(target=thread_func) for _ in range(10)
+        ]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+
+    def test_arena_reset(self) -> None:
+        self.assertTrue(arena_reset_reuses())
+
+    def test_arena_large_alloc(self) -> None:
+        arena_large()
+
+
 if __name__ == "__main__":
     unittest.main()
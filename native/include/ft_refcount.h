@@ -12,6 +12,14 @@
  */
 void ConcurrentRegisterReference(PyObject* obj);
 
+/**
+ * Registers a whole array of objects in one call; NULL entries are skipped.
+ * Equivalent to calling ConcurrentRegisterReference on each object but
+ * without the per-object function call cost, for bulk-load paths which
+ * publish many objects at once.
+ */
+void ConcurrentRegisterReferenceBatch(PyObject** objs, Py_ssize_t n);
+
 /**
  * Returns a new reference to the passed object reference.
  * This is an concurrent safe implementation of loading the reference from a
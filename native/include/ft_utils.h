@@ -15,6 +15,7 @@ typedef DWORD THREAD_TYPE;
 typedef CRITICAL_SECTION MUTEX_TYPE;
 typedef CONDITION_VARIABLE COND_TYPE;
 #define THREAD_ID GetCurrentThreadId()
+#define THREAD_EQUAL(a, b) ((a) == (b))
 #define MUTEX_INIT(mutex) (InitializeCriticalSection(&mutex), 0)
 #define MUTEX_DESTROY(mutex) (DeleteCriticalSection(&mutex), 0)
 #define MUTEX_LOCK(mutex) (EnterCriticalSection(&mutex))
@@ -29,6 +30,18 @@ static int cond_wait(COND_TYPE* cond, MUTEX_TYPE* mutex) {
 }
 
 #define COND_WAIT(cond, mutex) (cond_wait(&cond, &mutex))
+
+// NOLINTNEXTLINE
+static inline int
+cond_timedwait(COND_TYPE* cond, MUTEX_TYPE* mutex, int64_t timeout_us) {
+  BOOL result =
+      SleepConditionVariableCS(cond, mutex, (DWORD)((timeout_us + 999) / 1000));
+  return result ? 0 : 1;
+}
+
+/* Wait with a timeout in microseconds; returns non-zero on timeout. */
+#define COND_TIMEDWAIT(cond, mutex, timeout_us) \
+  (cond_timedwait(&cond, &mutex, timeout_us))
 #define COND_SIGNAL(cond) (WakeConditionVariable(&cond))
 #define COND_BROADCAST(cond) (WakeAllConditionVariable(&cond))
 
@@ -38,6 +51,7 @@ static int cond_wait(COND_TYPE* cond, MUTEX_TYPE* mutex) {
 
 #define THREAD_TYPE pthread_t
 #define THREAD_ID pthread_self()
+#define THREAD_EQUAL(a, b) (pthread_equal((a), (b)))
 #define MUTEX_TYPE pthread_mutex_t
 #define COND_TYPE pthread_cond_t
 #define MUTEX_INIT(mutex) (pthread_mutex_init(&mutex, NULL) != 0)
@@ -47,6 +61,24 @@ static int cond_wait(COND_TYPE* cond, MUTEX_TYPE* mutex) {
 #define COND_INIT(cond) (pthread_cond_init(&cond, NULL) != 0)
 #define COND_DESTROY(cond) (pthread_cond_destroy(&cond) != 0)
 #define COND_WAIT(cond, mutex) (pthread_cond_wait(&cond, &mutex))
+
+// NOLINTNEXTLINE
+static inline int
+cond_timedwait(COND_TYPE* cond, MUTEX_TYPE* mutex, int64_t timeout_us) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += (time_t)(timeout_us / 1000000);
+  deadline.tv_nsec += (long)((timeout_us % 1000000) * 1000);
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+/* Wait with a timeout in microseconds; returns non-zero on timeout. */
+#define COND_TIMEDWAIT(cond, mutex, timeout_us) \
+  (cond_timedwait(&cond, &mutex, timeout_us))
 #define COND_SIGNAL(cond) (pthread_cond_signal(&cond))
 #define COND_BROADCAST(cond) (pthread_cond_broadcast(&cond))
 #endif
@@ -114,4 +146,41 @@ static inline int64_t atomic_int64_div(int64_t* obj, int64_t value) {
   return expected;
 }
 
+/* Public C API capsule
+   ====================
+
+   Exported by ft_utils._concurrency as _C_API in the style of CPython's
+   datetime capsule. Third party native code imports the capsule once and
+   then operates on the concurrent structures at plain C call cost with no
+   Python level dispatch per operation.
+
+   Every function type checks its first argument and reports failure through
+   the usual Python conventions: functions returning PyObject* return NULL
+   with an exception set, functions returning int return -1. */
+typedef struct {
+  /* Returns a new reference; KeyError when the key is absent. */
+  PyObject* (*ConcurrentDict_GetItem)(PyObject* dict, PyObject* key);
+  /* A NULL value deletes the key. */
+  int (
+      *ConcurrentDict_SetItem)(PyObject* dict, PyObject* key, PyObject* value);
+  /* Atomically adds amount, storing the new value through result when it is
+     not NULL. */
+  int (*AtomicInt64_Add)(PyObject* atomic, int64_t amount, int64_t* result);
+  /* Pushes onto the right end of the deque. */
+  int (*ConcurrentDeque_Push)(PyObject* deque, PyObject* item);
+  /* Return new references; RuntimeError when the deque is empty. Pop takes
+     from the right end, PopLeft from the left. */
+  PyObject* (*ConcurrentDeque_Pop)(PyObject* deque);
+  PyObject* (*ConcurrentDeque_PopLeft)(PyObject* deque);
+} FTUtils_CAPI;
+
+#define FT_UTILS_CAPI_NAME "ft_utils._concurrency._C_API"
+
+/* Import the capsule; returns NULL with an exception set on failure. The
+   importing module must already be able to import ft_utils._concurrency. */
+// NOLINTNEXTLINE
+static inline FTUtils_CAPI* FTUtils_ImportCAPI(void) {
+  return (FTUtils_CAPI*)PyCapsule_Import(FT_UTILS_CAPI_NAME, 0);
+}
+
 #endif /* FT_UTILS_H */
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 typedef uint64_t ustimestamp_t;
+typedef uint64_t nstimestamp_t;
 
 #if defined(_WIN32) || defined(_WIN64)
 
@@ -33,6 +34,19 @@ static ustimestamp_t us_time(void) {
   return (ustimestamp_t)((ustimestamp_t)counter.QuadPart / frequency);
 }
 
+/* Nanosecond resolution monotonic clock for fine grained measurement. The
+   split division avoids overflowing the counter when scaling to ns. */
+// NOLINTNEXTLINE
+static nstimestamp_t ns_time(void) {
+  LARGE_INTEGER freq;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&counter);
+  nstimestamp_t ticks = (nstimestamp_t)counter.QuadPart;
+  nstimestamp_t hz = (nstimestamp_t)freq.QuadPart;
+  return (ticks / hz) * 1000000000ull + ((ticks % hz) * 1000000000ull) / hz;
+}
+
 #else
 
 #include <pthread.h>
@@ -45,6 +59,20 @@ static ustimestamp_t us_time(void) {
   return (ustimestamp_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
 }
 
+/* Nanosecond resolution monotonic clock for fine grained measurement. Uses
+   the raw clock where available so NTP slewing cannot distort short
+   intervals. */
+// NOLINTNEXTLINE
+static nstimestamp_t ns_time(void) {
+  struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+  return (nstimestamp_t)ts.tv_sec * 1000000000ull + (nstimestamp_t)ts.tv_nsec;
+}
+
 #endif
 
 // NOLINTNEXTLINE
@@ -104,7 +104,7 @@ static inline PyObject* _py_get_function(
    modules and prevents inter-extension runtime communication other than through
    Python itself.  Returns zero on success, one on failure.*/
 // NOLINTNEXTLINE
-static int _py_register_wvls_destructor(
+static inline int _py_register_wvls_destructor(
     void** wvls_var,
     wvls_destructor_t wvls_destructor) {
   PyObject* p_var = NULL;
@@ -153,12 +153,138 @@ cleanup:
   return ret_val;
 }
 
+/* Per-thread arena allocator.
+   ===========================
+
+   A simple bump allocator over chunks of malloc'd memory, one arena per
+   thread per translation unit. Small node allocations served from the arena
+   never touch a shared allocator so they pay no cross-thread lock or cache
+   line traffic; the price is that individual allocations cannot be freed,
+   only the whole arena reset or torn down. Teardown is automatic: the first
+   allocation on a thread registers the arena with the wvls destructor
+   mechanism and the destructor frees the chunks with no Python calls, as
+   wvls_destructor_t requires.
+
+   Like the _py_* helpers above these are static so each translation unit
+   gets its own arena; an arena is state of the allocator, not shared state,
+   so this is exactly what we want. */
+
+#define WVLS_ARENA_CHUNK_SIZE ((size_t)(64 * 1024))
+#define WVLS_ARENA_ALIGNMENT ((size_t)16)
+
+typedef struct wvls_arena_chunk {
+  struct wvls_arena_chunk* next;
+  size_t capacity;
+  size_t used;
+  size_t padding; /* Keeps the chunk memory WVLS_ARENA_ALIGNMENT aligned. */
+  /* The chunk memory follows this header. */
+} wvls_arena_chunk_t;
+
+typedef struct wvls_arena {
+  wvls_arena_chunk_t* chunks;
+} wvls_arena_t;
+
+static weave_local wvls_arena_t* _wvls_arena = NULL;
+
+/* Runs at thread death via the wvls destructor mechanism; must not call into
+   the interpreter so the chunks come from plain malloc. */
+// NOLINTNEXTLINE
+static void _wvls_arena_destructor(void* arg) {
+  wvls_arena_t* arena = (wvls_arena_t*)arg;
+  if (!arena) {
+    return;
+  }
+  wvls_arena_chunk_t* chunk = arena->chunks;
+  while (chunk) {
+    wvls_arena_chunk_t* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  free(arena);
+}
+
+// NOLINTNEXTLINE
+static inline wvls_arena_chunk_t* _wvls_arena_chunk_new(size_t capacity) {
+  wvls_arena_chunk_t* chunk =
+      (wvls_arena_chunk_t*)malloc(sizeof(wvls_arena_chunk_t) + capacity);
+  if (!chunk) {
+    return NULL;
+  }
+  chunk->next = NULL;
+  chunk->capacity = capacity;
+  chunk->used = 0;
+  return chunk;
+}
+
+/* Allocate size bytes from the calling thread's arena. The memory is aligned
+   to WVLS_ARENA_ALIGNMENT and stays valid until wvls_arena_reset or thread
+   death. Returns NULL with a Python error set on failure (which includes the
+   destructor registration failing, since without it the arena would leak). */
+// NOLINTNEXTLINE
+static inline void* wvls_arena_alloc(size_t size) {
+  size = (size + WVLS_ARENA_ALIGNMENT - 1) & ~(WVLS_ARENA_ALIGNMENT - 1);
+
+  wvls_arena_t* arena = _wvls_arena;
+  if (!arena) {
+    arena = (wvls_arena_t*)malloc(sizeof(wvls_arena_t));
+    if (!arena) {
+      PyErr_NoMemory();
+      return NULL;
+    }
+    arena->chunks = NULL;
+    if (_py_register_wvls_destructor(
+            (void**)&_wvls_arena, &_wvls_arena_destructor)) {
+      free(arena);
+      return NULL;
+    }
+    _wvls_arena = arena;
+  }
+
+  wvls_arena_chunk_t* chunk = arena->chunks;
+  if (!chunk || chunk->capacity - chunk->used < size) {
+    size_t capacity =
+        size > WVLS_ARENA_CHUNK_SIZE ? size : WVLS_ARENA_CHUNK_SIZE;
+    chunk = _wvls_arena_chunk_new(capacity);
+    if (!chunk) {
+      PyErr_NoMemory();
+      return NULL;
+    }
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+  }
+
+  void* allocation = (char*)chunk + sizeof(wvls_arena_chunk_t) + chunk->used;
+  chunk->used += size;
+  return allocation;
+}
+
+/* Bulk-free everything allocated from the calling thread's arena. The newest
+   chunk is kept with its space made available again so steady state cycles
+   of alloc and reset do not go back to malloc; older chunks are returned. */
+// NOLINTNEXTLINE
+static inline void wvls_arena_reset(void) {
+  wvls_arena_t* arena = _wvls_arena;
+  if (!arena || !arena->chunks) {
+    return;
+  }
+  wvls_arena_chunk_t* chunk = arena->chunks->next;
+  arena->chunks->used = 0;
+  arena->chunks->next = NULL;
+  while (chunk) {
+    wvls_arena_chunk_t* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+}
+
 /* The equivalent for _py_register_wvls_destructor but calls
 unregister_native_destructor. It will set *unregistered to 1 if a destructor was
 removed other wise this will be set to 0. Returns zero on success, one on
 failure. */
 // NOLINTNEXTLINE
-static int _py_unregister_wvls_destructor(void** wvls_var, int* unregistered) {
+static inline int _py_unregister_wvls_destructor(
+    void** wvls_var,
+    int* unregistered) {
   PyObject* p_var = NULL;
   PyObject* p_func = NULL;
   PyObject* p_args = NULL;
@@ -2,10 +2,44 @@
 
 #include "ft_utils.h"
 
+#include "concurrent_data_structures/atomic_flag.h"
 #include "concurrent_data_structures/atomic_int64.h"
+#include "concurrent_data_structures/atomic_int64_array.h"
 #include "concurrent_data_structures/atomic_reference.h"
+#include "concurrent_data_structures/atomic_reference_array.h"
 #include "concurrent_data_structures/concurrent_deque.h"
 #include "concurrent_data_structures/concurrent_dict.h"
+#include "concurrent_data_structures/concurrent_queue.h"
+#include "concurrent_data_structures/concurrent_ring_queue.h"
+#include "concurrent_data_structures/concurrent_set.h"
+#include "concurrent_data_structures/shared_dict.h"
+
+/* Bulk-register a sequence of objects with the concurrent reference API in
+ * one native pass, for code which is about to publish many objects into
+ * concurrent structures and does not want the per-object call cost.
+ */
+static PyObject* concurrency_register_reference_batch(
+    PyObject* Py_UNUSED(module),
+    PyObject* sequence) {
+  PyObject* fast = PySequence_Fast(
+      sequence, "register_reference_batch requires an iterable");
+  if (fast == NULL) {
+    return NULL;
+  }
+  ConcurrentRegisterReferenceBatch(
+      PySequence_Fast_ITEMS(fast), PySequence_Fast_GET_SIZE(fast));
+  Py_DECREF(fast);
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef concurrency_module_methods[] = {
+    {"register_reference_batch",
+     concurrency_register_reference_batch,
+     METH_O,
+     PyDoc_STR(
+         "register_reference_batch(iterable) -> None. Register every object in "
+         "the iterable with the concurrent reference API in one pass.")},
+    {NULL, NULL, 0, NULL}};
 
 static int exec_local_module(PyObject* module) {
   if (PyType_Ready(&ConcurrentDictType) < 0) {
@@ -14,30 +48,80 @@ static int exec_local_module(PyObject* module) {
   if (PyType_Ready(&ConcurrentDictIteratorType) < 0) {
     return -1;
   }
+  if (PyType_Ready(&ConcurrentDictSnapshotIteratorType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&AtomicFlagType) < 0) {
+    return -1;
+  }
   if (PyType_Ready(&AtomicInt64Type) < 0) {
     return -1;
   }
+  if (PyType_Ready(&AtomicInt64ArrayType) < 0) {
+    return -1;
+  }
   if (PyType_Ready(&AtomicReferenceType) < 0) {
     return -1;
   }
+  if (PyType_Ready(&AtomicReferenceArrayType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&AtomicStampedReferenceType) < 0) {
+    return -1;
+  }
   if (PyType_Ready(&ConcurrentDequeType) < 0) {
     return -1;
   }
   if (PyType_Ready(&ConcurrentDequeIteratorType) < 0) {
     return -1;
   }
+  if (PyType_Ready(&ConcurrentQueueType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&ConcurrentRingQueueType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&ConcurrentSetType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&ConcurrentSetIteratorType) < 0) {
+    return -1;
+  }
+  if (PyType_Ready(&SharedMemoryDictType) < 0) {
+    return -1;
+  }
   if (PyModule_AddObjectRef(
           module, "ConcurrentDict", (PyObject*)&ConcurrentDictType) < 0) {
     return -1;
   }
+  if (PyModule_AddObjectRef(
+          module, "AtomicFlag", (PyObject*)&AtomicFlagType) < 0) {
+    return -1;
+  }
   if (PyModule_AddObjectRef(
           module, "AtomicInt64", (PyObject*)&AtomicInt64Type) < 0) {
     return -1;
   }
+  if (PyModule_AddObjectRef(
+          module, "AtomicInt64Array", (PyObject*)&AtomicInt64ArrayType) < 0) {
+    return -1;
+  }
   if (PyModule_AddObjectRef(
           module, "AtomicReference", (PyObject*)&AtomicReferenceType) < 0) {
     return -1;
   }
+  if (PyModule_AddObjectRef(
+          module,
+          "AtomicReferenceArray",
+          (PyObject*)&AtomicReferenceArrayType) < 0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module,
+          "AtomicStampedReference",
+          (PyObject*)&AtomicStampedReferenceType) < 0) {
+    return -1;
+  }
   if (PyModule_AddObjectRef(
           module, "ConcurrentDeque", (PyObject*)&ConcurrentDequeType) < 0) {
     return -1;
@@ -54,6 +138,55 @@ static int exec_local_module(PyObject* module) {
           (PyObject*)&ConcurrentDictIteratorType) < 0) {
     return -1;
   }
+  if (PyModule_AddObjectRef(
+          module,
+          "ConcurrentDictSnapshotIterator",
+          (PyObject*)&ConcurrentDictSnapshotIteratorType) < 0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module, "ConcurrentQueue", (PyObject*)&ConcurrentQueueType) < 0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module, "ConcurrentRingQueue", (PyObject*)&ConcurrentRingQueueType) <
+      0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module, "ConcurrentSet", (PyObject*)&ConcurrentSetType) < 0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module,
+          "ConcurrentSetIterator",
+          (PyObject*)&ConcurrentSetIteratorType) < 0) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(
+          module, "SharedMemoryDict", (PyObject*)&SharedMemoryDictType) < 0) {
+    return -1;
+  }
+
+  /* The C API capsule; see the FTUtils_CAPI notes in ft_utils.h. The struct
+     is static so the capsule stays valid for the life of the process. */
+  static FTUtils_CAPI capi = {
+      ConcurrentDict_GetItem,
+      ConcurrentDict_SetItem,
+      AtomicInt64_Add,
+      ConcurrentDeque_Push,
+      ConcurrentDeque_Pop,
+      ConcurrentDeque_PopLeft,
+  };
+  PyObject* capsule = PyCapsule_New(&capi, FT_UTILS_CAPI_NAME, NULL);
+  if (capsule == NULL) {
+    return -1;
+  }
+  if (PyModule_AddObjectRef(module, "_C_API", capsule) < 0) {
+    Py_DECREF(capsule);
+    return -1;
+  }
+  Py_DECREF(capsule);
 
   return 0;
 }
@@ -69,7 +202,7 @@ static PyModuleDef concurrency_module = {
     "_concurrency",
     "Concurrently scalable data structures and patterns.",
     0,
-    NULL,
+    concurrency_module_methods,
     module_slots,
     NULL,
     NULL,
@@ -0,0 +1,343 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+#include <Python.h>
+#include "ft_compat.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/* Native parallel sort.
+   =====================
+
+   parallel_sort(target, threads=0) sorts a list in place across native
+   threads. The list contents are snapshotted so comparators never see a
+   half-sorted list, the snapshot is split into equal segments which are
+   sorted concurrently with list.sort (so each segment still gets timsort
+   and its specialized compares), and the sorted runs are combined with
+   stable pairwise merges, themselves run concurrently within each round.
+
+   Worker threads attach to the interpreter with PyGILState_Ensure before
+   touching any object, so on default builds they serialize on the GIL
+   and the sort degrades to a sequential merge sort; on free-threaded
+   builds segments sort and merge genuinely in parallel. The calling
+   thread detaches while it waits so workers are never blocked on it. */
+
+/* Segments smaller than this are not worth a thread; below two of them
+   the whole call is handed straight to list.sort. */
+#define SORT_MIN_SEGMENT 1024
+
+/* How many merge steps run between polls of the shared failure flag. */
+#define SORT_ABORT_POLL 1024
+
+/* First comparator failure wins; everything else winds down quietly.
+   The mutex guards the exception slots, the flag is polled lock-free. */
+typedef struct {
+  int failed;
+  PyThread_type_lock mutex;
+  PyObject* exc_type;
+  PyObject* exc_value;
+  PyObject* exc_traceback;
+} sort_error_t;
+
+typedef struct {
+  PyObject** items;
+  PyObject** scratch;
+  Py_ssize_t lo;
+  Py_ssize_t mid; /* < 0: sort [lo, hi); otherwise merge [lo, mid) [mid, hi) */
+  Py_ssize_t hi;
+  sort_error_t* error;
+  PyThread_type_lock done; /* NULL means run on the calling thread */
+} sort_task_t;
+
+/* Move the pending exception of this thread into the shared error slots
+   if no other thread got there first, otherwise drop it. */
+static void sort_error_record(sort_error_t* error) {
+  PyThread_acquire_lock(error->mutex, 1);
+  if (error->exc_type == NULL) {
+    PyErr_Fetch(&error->exc_type, &error->exc_value, &error->exc_traceback);
+  } else {
+    PyErr_Clear();
+  }
+  _Py_atomic_store_int32_relaxed(&error->failed, 1);
+  PyThread_release_lock(error->mutex);
+}
+
+static int sort_aborted(sort_error_t* error) {
+  return _Py_atomic_load_int32_relaxed(&error->failed);
+}
+
+/* Sort items[lo:hi) by round-tripping the pointers through a private
+   list and list.sort, so segments keep timsort's adaptivity and its
+   specialized compares. The private list borrows the references and is
+   emptied again before it is released, whether the sort worked or not:
+   list.sort always reattaches the full pointer array, so the segment
+   stays a permutation of itself even when a comparator raises. */
+static int sort_segment(sort_task_t* task) {
+  Py_ssize_t length = task->hi - task->lo;
+  PyObject* segment = PyList_New(length);
+  if (segment == NULL) {
+    sort_error_record(task->error);
+    return -1;
+  }
+  PyObject** items = task->items + task->lo;
+  for (Py_ssize_t index = 0; index < length; ++index) {
+    PyList_SET_ITEM(segment, index, items[index]);
+  }
+  int status = PyList_Sort(segment);
+  for (Py_ssize_t index = 0; index < length; ++index) {
+    items[index] = PyList_GET_ITEM(segment, index);
+    PyList_SET_ITEM(segment, index, NULL);
+  }
+  Py_DECREF(segment);
+  if (status < 0) {
+    sort_error_record(task->error);
+    return -1;
+  }
+  return 0;
+}
+
+/* Stable in-place merge of items[lo:mid) and items[mid:hi) through the
+   scratch buffer. On abort the unconsumed tails are copied back in
+   order so the range is always left a permutation of its input. */
+static int sort_merge(sort_task_t* task) {
+  PyObject** items = task->items;
+  PyObject** scratch = task->scratch;
+  Py_ssize_t lo = task->lo;
+  Py_ssize_t mid = task->mid;
+  Py_ssize_t hi = task->hi;
+  memcpy(scratch + lo, items + lo, (size_t)(hi - lo) * sizeof(PyObject*));
+  Py_ssize_t left = lo;
+  Py_ssize_t right = mid;
+  Py_ssize_t out = lo;
+  int failed = 0;
+  while (left < mid && right < hi) {
+    if (((out - lo) & (SORT_ABORT_POLL - 1)) == 0 && sort_aborted(task->error)) {
+      failed = 1;
+      break;
+    }
+    /* Take from the right run only when it is strictly smaller, which
+       keeps equal elements in their original order. */
+    int take_right = PyObject_RichCompareBool(scratch[right], scratch[left], Py_LT);
+    if (take_right < 0) {
+      sort_error_record(task->error);
+      failed = 1;
+      break;
+    }
+    items[out++] = take_right ? scratch[right++] : scratch[left++];
+  }
+  while (left < mid) {
+    items[out++] = scratch[left++];
+  }
+  while (right < hi) {
+    items[out++] = scratch[right++];
+  }
+  return failed ? -1 : 0;
+}
+
+static void sort_task_execute(sort_task_t* task) {
+  if (sort_aborted(task->error)) {
+    return;
+  }
+  if (task->mid < 0) {
+    sort_segment(task);
+  } else {
+    sort_merge(task);
+  }
+}
+
+static void sort_task_thread(void* arg) {
+  sort_task_t* task = (sort_task_t*)arg;
+  PyGILState_STATE gil_state = PyGILState_Ensure();
+  sort_task_execute(task);
+  PyGILState_Release(gil_state);
+  PyThread_release_lock(task->done);
+}
+
+/* Run tasks[1:] on spawned threads and tasks[0] on the calling thread,
+   which detaches while it waits. A task whose thread or lock cannot be
+   created simply runs on the calling thread as well. */
+static void sort_run_tasks(sort_task_t* tasks, Py_ssize_t count) {
+  for (Py_ssize_t index = 1; index < count; ++index) {
+    sort_task_t* task = &tasks[index];
+    task->done = PyThread_allocate_lock();
+    if (task->done == NULL) {
+      continue;
+    }
+    PyThread_acquire_lock(task->done, 1);
+    if (PyThread_start_new_thread(sort_task_thread, task) < 0) {
+      PyThread_release_lock(task->done);
+      PyThread_free_lock(task->done);
+      task->done = NULL;
+    }
+  }
+  sort_task_execute(&tasks[0]);
+  for (Py_ssize_t index = 1; index < count; ++index) {
+    if (tasks[index].done == NULL) {
+      sort_task_execute(&tasks[index]);
+    }
+  }
+  Py_BEGIN_ALLOW_THREADS;
+  for (Py_ssize_t index = 1; index < count; ++index) {
+    if (tasks[index].done != NULL) {
+      PyThread_acquire_lock(tasks[index].done, 1);
+    }
+  }
+  Py_END_ALLOW_THREADS;
+  for (Py_ssize_t index = 1; index < count; ++index) {
+    if (tasks[index].done != NULL) {
+      PyThread_release_lock(tasks[index].done);
+      PyThread_free_lock(tasks[index].done);
+      tasks[index].done = NULL;
+    }
+  }
+}
+
+static Py_ssize_t sort_cpu_count(void) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (Py_ssize_t)info.dwNumberOfProcessors;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (Py_ssize_t)count : 1;
+#endif
+}
+
+static PyObject*
+sort_parallel_sort(PyObject* Py_UNUSED(module), PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = {"target", "threads", NULL};
+  PyObject* target = NULL;
+  Py_ssize_t threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "O!|n", kwlist, &PyList_Type, &target, &threads)) {
+    return NULL;
+  }
+  if (threads <= 0) {
+    threads = sort_cpu_count();
+  }
+  Py_ssize_t size = PyList_GET_SIZE(target);
+
+  /* A power of two segment count keeps the merge rounds exact pairs. */
+  Py_ssize_t segments = 1;
+  while (segments * 2 <= threads && size / (segments * 2) >= SORT_MIN_SEGMENT) {
+    segments *= 2;
+  }
+  if (segments < 2) {
+    if (PyList_Sort(target) < 0) {
+      return NULL;
+    }
+    Py_RETURN_NONE;
+  }
+
+  /* Sort a snapshot so comparators that read the target never observe a
+     half-sorted list and mutation of the target cannot corrupt the sort;
+     this is the same detachment trick list.sort itself uses. */
+  PyObject* snapshot = PyList_GetSlice(target, 0, size);
+  if (snapshot == NULL) {
+    return NULL;
+  }
+  PyObject** items = PySequence_Fast_ITEMS(snapshot);
+  PyObject** scratch = (PyObject**)PyMem_Malloc((size_t)size * sizeof(PyObject*));
+  sort_task_t* tasks =
+      (sort_task_t*)PyMem_Malloc((size_t)segments * sizeof(sort_task_t));
+  Py_ssize_t* bounds =
+      (Py_ssize_t*)PyMem_Malloc((size_t)(segments + 1) * sizeof(Py_ssize_t));
+  sort_error_t error = {0, PyThread_allocate_lock(), NULL, NULL, NULL};
+  if (scratch == NULL || tasks == NULL || bounds == NULL ||
+      error.mutex == NULL) {
+    PyMem_Free(scratch);
+    PyMem_Free(tasks);
+    PyMem_Free(bounds);
+    if (error.mutex != NULL) {
+      PyThread_free_lock(error.mutex);
+    }
+    Py_DECREF(snapshot);
+    return PyErr_NoMemory();
+  }
+  for (Py_ssize_t index = 0; index <= segments; ++index) {
+    Py_ssize_t extra = index < size % segments ? index : size % segments;
+    bounds[index] = (size / segments) * index + extra;
+  }
+
+  for (Py_ssize_t index = 0; index < segments; ++index) {
+    sort_task_t task =
+        {items, scratch, bounds[index], -1, bounds[index + 1], &error, NULL};
+    tasks[index] = task;
+  }
+  sort_run_tasks(tasks, segments);
+
+  for (Py_ssize_t width = 1; width < segments && !sort_aborted(&error);
+       width *= 2) {
+    Py_ssize_t count = 0;
+    for (Py_ssize_t index = 0; index + width < segments; index += 2 * width) {
+      sort_task_t task =
+          {items,
+           scratch,
+           bounds[index],
+           bounds[index + width],
+           bounds[index + 2 * width],
+           &error,
+           NULL};
+      tasks[count++] = task;
+    }
+    sort_run_tasks(tasks, count);
+  }
+
+  int status = 0;
+  if (error.exc_type != NULL) {
+    PyErr_Restore(error.exc_type, error.exc_value, error.exc_traceback);
+    status = -1;
+  } else if (PyList_GET_SIZE(target) != size) {
+    PyErr_SetString(PyExc_ValueError, "list modified during sort");
+    status = -1;
+  } else {
+    status = PyList_SetSlice(target, 0, size, snapshot);
+  }
+
+  PyMem_Free(scratch);
+  PyMem_Free(tasks);
+  PyMem_Free(bounds);
+  PyThread_free_lock(error.mutex);
+  Py_DECREF(snapshot);
+  if (status < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static struct PyModuleDef_Slot sort_module_slots[] = {
+    _PY_NOGIL_MODULE_SLOT // NOLINT
+    {0, NULL} /* sentinel */
+};
+
+static PyMethodDef sort_module_methods[] = {
+    {"parallel_sort",
+     (PyCFunction)(void (*)(void))sort_parallel_sort,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "parallel_sort(target, threads=0)\n"
+         "Stable in-place sort of a list using up to threads native\n"
+         "threads (0 means the CPU count). Segments are sorted with\n"
+         "list.sort and combined with stable merges; small lists are\n"
+         "handed straight to list.sort. Only effectively parallel on\n"
+         "free-threaded builds.")},
+    {NULL, NULL, 0, NULL}};
+
+static PyModuleDef sort_module = {
+    PyModuleDef_HEAD_INIT,
+    "_sort",
+    PyDoc_STR("Parallel sorting primitives."),
+    0,
+    sort_module_methods,
+    sort_module_slots,
+    NULL,
+    NULL,
+    NULL};
+
+PyMODINIT_FUNC PyInit__sort(void) {
+  return PyModuleDef_Init(&sort_module);
+}
@@ -0,0 +1,199 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "atomic_flag.h"
+
+/* An atomic boolean flag with blocking waits. Reads and writes are plain
+ * atomics, so set() and bool() stay allocation free and uncontended; waiters
+ * park on a condition variable and are woken by the set() that flips the flag
+ * their way, replacing the sleep-quantum polling that the Python wrapper over
+ * AtomicInt64 forced on callers. Setters only touch the mutex when a waiter
+ * is actually parked.
+ */
+typedef struct {
+  PyObject_HEAD int64_t value;
+  MUTEX_TYPE mutex;
+  COND_TYPE changed; /* signalled on every set() while waiters exist */
+  int64_t waiters; /* threads parked or about to park */
+  PyObject* weakreflist;
+} AtomicFlagObject;
+
+static PyObject*
+atomicflag_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  int value = 0;
+
+  if (!PyArg_ParseTuple(args, "p", &value)) {
+    return NULL;
+  }
+
+  AtomicFlagObject* self = (AtomicFlagObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+
+  self->weakreflist = NULL;
+  self->waiters = 0;
+  _Py_atomic_store_int64(&self->value, value ? -1 : 0);
+
+  if (MUTEX_INIT(self->mutex)) {
+    Py_TYPE(self)->tp_free((PyObject*)self);
+    PyErr_SetString(PyExc_RuntimeError, "Failed to initialize mutex");
+    return NULL;
+  }
+  if (COND_INIT(self->changed)) {
+    MUTEX_DESTROY(self->mutex);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+    PyErr_SetString(PyExc_RuntimeError, "Failed to initialize condition");
+    return NULL;
+  }
+
+  return (PyObject*)self;
+}
+
+static void atomicflag_dealloc(AtomicFlagObject* self) {
+  PyObject_ClearWeakRefs((PyObject*)self);
+  COND_DESTROY(self->changed);
+  MUTEX_DESTROY(self->mutex);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int atomicflag_bool(AtomicFlagObject* self) {
+  return _Py_atomic_load_int64(&self->value) != 0;
+}
+
+static PyObject* atomicflag_set(AtomicFlagObject* self, PyObject* obj) {
+  int value = PyObject_IsTrue(obj);
+  if (value < 0) {
+    return NULL;
+  }
+
+  _Py_atomic_store_int64(&self->value, value ? -1 : 0);
+
+  /* The store above is sequentially consistent with the waiter's increment
+   * of waiters, so either we see the waiter here or the waiter sees the new
+   * value before parking; a wakeup cannot be lost.
+   */
+  if (_Py_atomic_load_int64(&self->waiters) > 0) {
+    Py_BEGIN_ALLOW_THREADS;
+    MUTEX_LOCK(self->mutex);
+    COND_BROADCAST(self->changed);
+    MUTEX_UNLOCK(self->mutex);
+    Py_END_ALLOW_THREADS;
+  }
+
+  Py_RETURN_NONE;
+}
+
+/* The shared wait loop: park until bool(flag) == desired or the timeout
+ * expires, returning True on success and False on timeout.
+ */
+static PyObject*
+atomicflag_wait(AtomicFlagObject* self, PyObject* args, int desired) {
+  PyObject* timeout_obj = Py_None;
+
+  if (!PyArg_ParseTuple(args, "|O", &timeout_obj)) {
+    return NULL;
+  }
+
+  int64_t timeout_us = -1;
+  if (timeout_obj != Py_None) {
+    double timeout = PyFloat_AsDouble(timeout_obj);
+    if (timeout == -1.0 && PyErr_Occurred()) {
+      return NULL;
+    }
+    timeout_us = timeout <= 0.0 ? 0 : (int64_t)(timeout * 1e6);
+  }
+
+  if ((_Py_atomic_load_int64(&self->value) != 0) == desired) {
+    Py_RETURN_TRUE;
+  }
+
+  int satisfied = 0;
+  ustimestamp_t start = us_time();
+
+  Py_BEGIN_ALLOW_THREADS;
+  MUTEX_LOCK(self->mutex);
+  _Py_atomic_add_int64(&self->waiters, 1);
+
+  for (;;) {
+    if ((_Py_atomic_load_int64(&self->value) != 0) == desired) {
+      satisfied = 1;
+      break;
+    }
+
+    if (timeout_us < 0) {
+      COND_WAIT(self->changed, self->mutex);
+    } else {
+      int64_t remaining = timeout_us - (int64_t)us_difftime(us_time(), start);
+      if (remaining <= 0 ||
+          COND_TIMEDWAIT(self->changed, self->mutex, remaining)) {
+        /* Timed out; one final check happens at the top of the loop on the
+         * next iteration, so bail only after re-checking here.
+         */
+        if ((_Py_atomic_load_int64(&self->value) != 0) == desired) {
+          satisfied = 1;
+        }
+        break;
+      }
+    }
+  }
+
+  _Py_atomic_add_int64(&self->waiters, -1);
+  MUTEX_UNLOCK(self->mutex);
+  Py_END_ALLOW_THREADS;
+
+  if (satisfied) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+}
+
+static PyObject* atomicflag_wait_until_set(
+    AtomicFlagObject* self,
+    PyObject* args) {
+  return atomicflag_wait(self, args, 1);
+}
+
+static PyObject* atomicflag_wait_until_clear(
+    AtomicFlagObject* self,
+    PyObject* args) {
+  return atomicflag_wait(self, args, 0);
+}
+
+static PyMethodDef atomicflag_methods[] = {
+    {"set", (PyCFunction)atomicflag_set, METH_O, "Atomically set the flag"},
+    {"wait_until_set",
+     (PyCFunction)atomicflag_wait_until_set,
+     METH_VARARGS,
+     "Block until the flag is true, or the timeout (in seconds) expires.\n"
+     "Returns whether the flag was true."},
+    {"wait_until_clear",
+     (PyCFunction)atomicflag_wait_until_clear,
+     METH_VARARGS,
+     "Block until the flag is false, or the timeout (in seconds) expires.\n"
+     "Returns whether the flag was false."},
+    {NULL, NULL, 0, NULL}};
+
+static PyNumberMethods atomicflag_as_number = {
+    .nb_bool = (inquiry)atomicflag_bool,
+};
+
+PyTypeObject AtomicFlagType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "_concurrency.AtomicFlag",
+    .tp_basicsize = sizeof(AtomicFlagObject),
+    .tp_itemsize = 0,
+    .tp_dealloc = (destructor)atomicflag_dealloc,
+    .tp_as_number = &atomicflag_as_number,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc =
+        "AtomicFlag(value)\n"
+        "--\n"
+        "\n"
+        "An atomic boolean flag. Waiters park on a condition variable and\n"
+        "are woken by the set() that changes the flag, so there is no\n"
+        "polling loop between the two.",
+    .tp_new = atomicflag_new,
+    .tp_methods = atomicflag_methods,
+    .tp_weaklistoffset = offsetof(AtomicFlagObject, weakreflist),
+};
@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef ATOMIC_FLAG_H
+#define ATOMIC_FLAG_H
+
+#include <Python.h>
+
+extern PyTypeObject AtomicFlagType;
+
+#endif /* ATOMIC_FLAG_H */
@@ -289,3 +289,20 @@ PyTypeObject AtomicInt64Type = {
     .tp_richcompare = (richcmpfunc)atomicint64_richcompare,
     .tp_weaklistoffset = offsetof(AtomicInt64Object, weakreflist),
 };
+
+/* C API entry point exported through the ft_utils capsule; see the
+   FTUtils_CAPI notes in ft_utils.h for the calling conventions. */
+
+int AtomicInt64_Add(PyObject* atomic, int64_t amount, int64_t* result) {
+  if (!PyObject_TypeCheck(atomic, &AtomicInt64Type)) {
+    PyErr_SetString(PyExc_TypeError, "expected an AtomicInt64");
+    return -1;
+  }
+  int64_t new_value =
+      _Py_atomic_add_int64(&((AtomicInt64Object*)atomic)->value, amount) +
+      amount;
+  if (result != NULL) {
+    *result = new_value;
+  }
+  return 0;
+}
@@ -7,4 +7,7 @@
 
 extern PyTypeObject AtomicInt64Type;
 
+/* C API entry point exported through the ft_utils capsule. */
+int AtomicInt64_Add(PyObject* atomic, int64_t amount, int64_t* result);
+
 #endif /* ATOMIC_INT64_H */
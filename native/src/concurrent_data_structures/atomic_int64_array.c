@@ -0,0 +1,301 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "atomic_int64_array.h"
+
+/* Counters are spaced one cache line apart so that threads hammering adjacent
+ * indices do not false-share, and the whole array lives in one allocation
+ * rather than one PyObject per counter.
+ */
+#define ATOMIC_INT64_ARRAY_CACHE_LINE 64
+#define ATOMIC_INT64_ARRAY_STRIDE \
+  (ATOMIC_INT64_ARRAY_CACHE_LINE / sizeof(int64_t))
+
+/* The number of per-thread stripes used when striping is requested. Each
+ * stripe of a counter sits on its own cache line and threads are spread over
+ * the stripes by their thread id, trading memory and read cost for contention
+ * free increments on hot counters.
+ */
+#define ATOMIC_INT64_ARRAY_STRIPES 8
+
+typedef struct {
+  PyObject_HEAD Py_ssize_t size;
+  Py_ssize_t stripes;
+  /* The base of the raw allocation; cells points into it at the first
+   * cache-line boundary.
+   */
+  void* raw;
+  int64_t* cells;
+  PyObject* weakreflist;
+} AtomicInt64ArrayObject;
+
+/* Return a pointer to the cell for the given index and stripe. Stripes of a
+ * counter are laid out consecutively, each on its own cache line.
+ */
+static inline int64_t* atomicint64array_cell(
+    AtomicInt64ArrayObject* self,
+    Py_ssize_t index,
+    Py_ssize_t stripe) {
+  return self->cells +
+      ((size_t)index * self->stripes + stripe) * ATOMIC_INT64_ARRAY_STRIDE;
+}
+
+/* Pick the stripe for the calling thread by mixing its thread id. With one
+ * stripe this is always zero.
+ */
+static inline Py_ssize_t atomicint64array_stripe(AtomicInt64ArrayObject* self) {
+  if (self->stripes == 1) {
+    return 0;
+  }
+  uintptr_t tid = (uintptr_t)THREAD_ID;
+  uintptr_t mixed = ((tid >> 4) ^ tid) * (uintptr_t)2654435761u;
+  return (Py_ssize_t)(mixed % (uintptr_t)self->stripes);
+}
+
+/* Check the given index against the bounds of the array, raising IndexError
+ * when it is out of range.
+ */
+static int atomicint64array_check_index(
+    AtomicInt64ArrayObject* self,
+    Py_ssize_t index) {
+  if (index < 0 || index >= self->size) {
+    PyErr_SetString(PyExc_IndexError, "AtomicInt64Array index out of range");
+    return -1;
+  }
+  return 0;
+}
+
+static PyObject*
+atomicint64array_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = {"size", "striped", NULL};
+  Py_ssize_t size = 0;
+  int striped = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|p", kwlist, &size, &striped)) {
+    return NULL;
+  }
+
+  if (size < 0) {
+    PyErr_SetString(PyExc_ValueError, "size must be non-negative");
+    return NULL;
+  }
+
+  AtomicInt64ArrayObject* self = (AtomicInt64ArrayObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+
+  self->size = size;
+  self->stripes = striped ? ATOMIC_INT64_ARRAY_STRIPES : 1;
+  self->weakreflist = NULL;
+
+  size_t bytes = (size_t)size * self->stripes * ATOMIC_INT64_ARRAY_CACHE_LINE +
+      ATOMIC_INT64_ARRAY_CACHE_LINE;
+
+  self->raw = PyMem_Calloc(1, bytes);
+  if (self->raw == NULL) {
+    Py_DECREF(self);
+    PyErr_NoMemory();
+    return NULL;
+  }
+
+  /* Align the first cell to a cache-line boundary. */
+  self->cells = (int64_t*)(((uintptr_t)self->raw +
+                            ATOMIC_INT64_ARRAY_CACHE_LINE - 1) &
+                           ~(uintptr_t)(ATOMIC_INT64_ARRAY_CACHE_LINE - 1));
+
+  return (PyObject*)self;
+}
+
+static void atomicint64array_dealloc(AtomicInt64ArrayObject* self) {
+  PyObject_ClearWeakRefs((PyObject*)self);
+  PyMem_Free(self->raw);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/* Sum the stripes of the counter at the given index. The per-stripe loads are
+ * atomic but the sum is not a point-in-time snapshot when striping is on.
+ */
+static int64_t atomicint64array_sum(
+    AtomicInt64ArrayObject* self,
+    Py_ssize_t index) {
+  int64_t total = 0;
+  for (Py_ssize_t stripe = 0; stripe < self->stripes; stripe++) {
+    total += _Py_atomic_load_int64(atomicint64array_cell(self, index, stripe));
+  }
+  return total;
+}
+
+static PyObject* atomicint64array_incr(
+    AtomicInt64ArrayObject* self,
+    PyObject* arg) {
+  Py_ssize_t index = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+
+  _Py_atomic_add_int64(
+      atomicint64array_cell(self, index, atomicint64array_stripe(self)), 1);
+  Py_RETURN_NONE;
+}
+
+static PyObject* atomicint64array_decr(
+    AtomicInt64ArrayObject* self,
+    PyObject* arg) {
+  Py_ssize_t index = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+
+  _Py_atomic_add_int64(
+      atomicint64array_cell(self, index, atomicint64array_stripe(self)), -1);
+  Py_RETURN_NONE;
+}
+
+static PyObject* atomicint64array_add(
+    AtomicInt64ArrayObject* self,
+    PyObject* args) {
+  Py_ssize_t index;
+  long long value;
+
+  if (!PyArg_ParseTuple(args, "nL", &index, &value)) {
+    return NULL;
+  }
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+
+  _Py_atomic_add_int64(
+      atomicint64array_cell(self, index, atomicint64array_stripe(self)),
+      value);
+  Py_RETURN_NONE;
+}
+
+static PyObject* atomicint64array_get(
+    AtomicInt64ArrayObject* self,
+    PyObject* arg) {
+  Py_ssize_t index = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+
+  return PyLong_FromLongLong(atomicint64array_sum(self, index));
+}
+
+static PyObject* atomicint64array_set(
+    AtomicInt64ArrayObject* self,
+    PyObject* args) {
+  Py_ssize_t index;
+  long long value;
+
+  if (!PyArg_ParseTuple(args, "nL", &index, &value)) {
+    return NULL;
+  }
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+
+  /* The value lands in the first stripe and the others are zeroed. Each store
+   * is atomic but the counter is not a single point-in-time write when
+   * striping is on; use set for initialization and resets, not as a
+   * synchronization point.
+   */
+  _Py_atomic_store_int64(atomicint64array_cell(self, index, 0), value);
+  for (Py_ssize_t stripe = 1; stripe < self->stripes; stripe++) {
+    _Py_atomic_store_int64(atomicint64array_cell(self, index, stripe), 0);
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* atomicint64array_to_list(AtomicInt64ArrayObject* self) {
+  PyObject* result = PyList_New(self->size);
+  if (result == NULL) {
+    return NULL;
+  }
+
+  for (Py_ssize_t index = 0; index < self->size; index++) {
+    PyObject* value = PyLong_FromLongLong(atomicint64array_sum(self, index));
+    if (value == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, index, value);
+  }
+
+  return result;
+}
+
+static Py_ssize_t atomicint64array_len(AtomicInt64ArrayObject* self) {
+  return self->size;
+}
+
+static PyObject* atomicint64array_item(
+    AtomicInt64ArrayObject* self,
+    Py_ssize_t index) {
+  if (atomicint64array_check_index(self, index) < 0) {
+    return NULL;
+  }
+  return PyLong_FromLongLong(atomicint64array_sum(self, index));
+}
+
+static PyMethodDef atomicint64array_methods[] = {
+    {"incr",
+     (PyCFunction)atomicint64array_incr,
+     METH_O,
+     "Atomically ++ the counter at the given index"},
+    {"decr",
+     (PyCFunction)atomicint64array_decr,
+     METH_O,
+     "Atomically -- the counter at the given index"},
+    {"add",
+     (PyCFunction)atomicint64array_add,
+     METH_VARARGS,
+     "Atomically add n to the counter at the given index"},
+    {"get",
+     (PyCFunction)atomicint64array_get,
+     METH_O,
+     "Get the value of the counter at the given index"},
+    {"set",
+     (PyCFunction)atomicint64array_set,
+     METH_VARARGS,
+     "Set the counter at the given index; intended for resets"},
+    {"to_list",
+     (PyCFunction)atomicint64array_to_list,
+     METH_NOARGS,
+     "Return the counter values as a list of ints"},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods atomicint64array_as_sequence = {
+    .sq_length = (lenfunc)atomicint64array_len,
+    .sq_item = (ssizeargfunc)atomicint64array_item,
+};
+
+PyTypeObject AtomicInt64ArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "_concurrency.AtomicInt64Array",
+    .tp_basicsize = sizeof(AtomicInt64ArrayObject),
+    .tp_itemsize = 0,
+    .tp_dealloc = (destructor)atomicint64array_dealloc,
+    .tp_as_sequence = &atomicint64array_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc =
+        "AtomicInt64Array(size, striped=False)\n"
+        "--\n"
+        "\n"
+        "A fixed-size array of atomic int64 counters held in one contiguous,\n"
+        "cache-line-padded buffer. With striped=True each counter is split\n"
+        "into per-thread stripes that are summed on read, which keeps hot\n"
+        "counters contention free at the cost of memory and read latency.",
+    .tp_new = atomicint64array_new,
+    .tp_methods = atomicint64array_methods,
+    .tp_weaklistoffset = offsetof(AtomicInt64ArrayObject, weakreflist),
+};
@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef ATOMIC_INT64_ARRAY_H
+#define ATOMIC_INT64_ARRAY_H
+
+#include <Python.h>
+
+extern PyTypeObject AtomicInt64ArrayType;
+
+#endif /* ATOMIC_INT64_ARRAY_H */
@@ -115,3 +115,209 @@ PyTypeObject AtomicReferenceType = {
     .tp_new = atomicreference_new,
     .tp_weaklistoffset = offsetof(AtomicReferenceObject, weakreflist),
 };
+
+/* A stamped variant of AtomicReference that pairs the reference with an
+ * integer stamp, checked and replaced together. The pair is held as an
+ * immutable tuple and every successful update swings the pointer to a freshly
+ * allocated tuple, so a recycled reference can never be mistaken for the one
+ * that was originally observed (the ABA problem): the stamp would have moved
+ * on and the tuple identity is new either way. This trades one small
+ * allocation per update for not needing a double-width compare exchange.
+ */
+typedef struct {
+  PyObject_HEAD PyObject* pair;
+  PyObject* weakreflist;
+} AtomicStampedReferenceObject;
+
+/* Build the (reference, stamp) tuple held by an AtomicStampedReference.
+ */
+static PyObject* atomicstampedreference_pair(PyObject* ref, int64_t stamp) {
+  PyObject* stamp_obj = PyLong_FromLongLong(stamp);
+  if (stamp_obj == NULL) {
+    return NULL;
+  }
+
+  PyObject* pair = PyTuple_Pack(2, ref, stamp_obj);
+  Py_DECREF(stamp_obj);
+  return pair;
+}
+
+static PyObject*
+atomicstampedreference_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  PyObject* ref = Py_None;
+  long long stamp = 0;
+
+  if (!PyArg_ParseTuple(args, "|OL", &ref, &stamp)) {
+    return NULL;
+  }
+
+  AtomicStampedReferenceObject* self =
+      (AtomicStampedReferenceObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+
+  self->weakreflist = NULL;
+  self->pair = atomicstampedreference_pair(ref, stamp);
+  if (self->pair == NULL) {
+    Py_DECREF(self);
+    return NULL;
+  }
+
+  ConcurrentRegisterReference(self->pair);
+  return (PyObject*)self;
+}
+
+static int atomicstampedreference_clear(AtomicStampedReferenceObject* self) {
+  Py_CLEAR(self->pair);
+  return 0;
+}
+
+static void atomicstampedreference_dealloc(AtomicStampedReferenceObject* self) {
+  PyObject_GC_UnTrack(self);
+  atomicstampedreference_clear(self);
+  PyObject_ClearWeakRefs((PyObject*)self);
+  PyObject_GC_Del(self);
+}
+
+static int atomicstampedreference_traverse(
+    AtomicStampedReferenceObject* self,
+    visitproc visit,
+    void* arg) {
+  Py_VISIT(_Py_atomic_load_ptr(&self->pair));
+  return 0;
+}
+
+/* Return the (reference, stamp) tuple; both values are from the same atomic
+ * snapshot.
+ */
+static PyObject* atomicstampedreference_get(
+    AtomicStampedReferenceObject* self) {
+  return ConcurrentGetNewReference(&self->pair);
+}
+
+static PyObject* atomicstampedreference_get_reference(
+    AtomicStampedReferenceObject* self) {
+  PyObject* pair = ConcurrentGetNewReference(&self->pair);
+  PyObject* ref = Py_NewRef(PyTuple_GET_ITEM(pair, 0));
+  Py_DECREF(pair);
+  return ref;
+}
+
+static PyObject* atomicstampedreference_get_stamp(
+    AtomicStampedReferenceObject* self) {
+  PyObject* pair = ConcurrentGetNewReference(&self->pair);
+  PyObject* stamp = Py_NewRef(PyTuple_GET_ITEM(pair, 1));
+  Py_DECREF(pair);
+  return stamp;
+}
+
+static PyObject* atomicstampedreference_set(
+    AtomicStampedReferenceObject* self,
+    PyObject* args) {
+  PyObject* ref;
+  long long stamp;
+
+  if (!PyArg_ParseTuple(args, "OL", &ref, &stamp)) {
+    return NULL;
+  }
+
+  PyObject* pair = atomicstampedreference_pair(ref, stamp);
+  if (pair == NULL) {
+    return NULL;
+  }
+
+  ConcurrentRegisterReference(pair);
+  PyObject* ret = _Py_atomic_exchange_ptr(&self->pair, pair);
+  Py_DECREF(ret);
+  Py_RETURN_NONE;
+}
+
+/* Atomically replace (expected, expected_stamp) with (value, new_stamp),
+ * returning whether the exchange happened. The reference is compared by
+ * identity and the stamp by value; new_stamp defaults to expected_stamp + 1.
+ */
+static PyObject* atomicstampedreference_compare_exchange(
+    AtomicStampedReferenceObject* self,
+    PyObject* args) {
+  PyObject* expected;
+  PyObject* value;
+  long long expected_stamp;
+  PyObject* new_stamp_obj = NULL;
+
+  if (!PyArg_ParseTuple(
+          args, "OOL|O", &expected, &value, &expected_stamp, &new_stamp_obj)) {
+    return NULL;
+  }
+
+  long long new_stamp;
+  if (new_stamp_obj == NULL) {
+    new_stamp = expected_stamp + 1;
+  } else {
+    new_stamp = PyLong_AsLongLong(new_stamp_obj);
+    if (new_stamp == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+
+  PyObject* new_pair = atomicstampedreference_pair(value, new_stamp);
+  if (new_pair == NULL) {
+    return NULL;
+  }
+
+  ConcurrentRegisterReference(new_pair);
+
+  for (;;) {
+    PyObject* pair = ConcurrentGetNewReference(&self->pair);
+    long long stamp = PyLong_AsLongLong(PyTuple_GET_ITEM(pair, 1));
+
+    if (PyTuple_GET_ITEM(pair, 0) != expected || stamp != expected_stamp) {
+      Py_DECREF(pair);
+      Py_DECREF(new_pair);
+      Py_RETURN_FALSE;
+    }
+
+    PyObject* observed = pair;
+    if (_Py_atomic_compare_exchange_ptr(&self->pair, &observed, new_pair)) {
+      /* Drop both the reference the field held and our temporary one. */
+      Py_DECREF(pair);
+      Py_DECREF(pair);
+      Py_RETURN_TRUE;
+    }
+
+    /* The pair moved between our read and the exchange; re-check it. */
+    Py_DECREF(pair);
+  }
+}
+
+static PyMethodDef AtomicStampedReference_methods[] = {
+    {"set", (PyCFunction)atomicstampedreference_set, METH_VARARGS},
+    {"get", (PyCFunction)atomicstampedreference_get, METH_NOARGS},
+    {"get_reference",
+     (PyCFunction)atomicstampedreference_get_reference,
+     METH_NOARGS},
+    {"get_stamp", (PyCFunction)atomicstampedreference_get_stamp, METH_NOARGS},
+    {"compare_exchange",
+     (PyCFunction)atomicstampedreference_compare_exchange,
+     METH_VARARGS},
+    {NULL}};
+
+PyTypeObject AtomicStampedReferenceType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name =
+        "_concurrency.AtomicStampedReference",
+    .tp_basicsize = sizeof(AtomicStampedReferenceObject),
+    .tp_dealloc = (destructor)atomicstampedreference_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc =
+        "AtomicStampedReference(value=None, stamp=0)\n"
+        "--\n"
+        "\n"
+        "An AtomicReference paired with an integer stamp that is checked and\n"
+        "advanced atomically with the reference, defeating the ABA problem\n"
+        "when references are recycled.",
+    .tp_traverse = (traverseproc)atomicstampedreference_traverse,
+    .tp_clear = (inquiry)atomicstampedreference_clear,
+    .tp_methods = AtomicStampedReference_methods,
+    .tp_new = atomicstampedreference_new,
+    .tp_weaklistoffset = offsetof(AtomicStampedReferenceObject, weakreflist),
+};
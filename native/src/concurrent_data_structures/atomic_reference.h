@@ -6,5 +6,6 @@
 #include <Python.h>
 
 extern PyTypeObject AtomicReferenceType;
+extern PyTypeObject AtomicStampedReferenceType;
 
 #endif /* ATOMIC_REFERENCE_H */
@@ -0,0 +1,272 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "atomic_reference_array.h"
+
+/* An array of atomically-updatable object slots held in one contiguous
+ * allocation, for slot-based lock-free structures (hazard-pointer tables,
+ * striped caches, sharded registries) where one AtomicReference object per
+ * slot would cost a separate heap object and header each. Every slot offers
+ * the same operations, and the same safe concurrent read path, as a
+ * standalone AtomicReference.
+ */
+typedef struct {
+  PyObject_HEAD Py_ssize_t size;
+  PyObject** slots;
+  PyObject* weakreflist;
+} AtomicReferenceArrayObject;
+
+/* Check the given index against the bounds of the array, raising IndexError
+ * when it is out of range.
+ */
+static int atomicreferencearray_check_index(
+    AtomicReferenceArrayObject* self,
+    Py_ssize_t index) {
+  if (index < 0 || index >= self->size) {
+    PyErr_SetString(
+        PyExc_IndexError, "AtomicReferenceArray index out of range");
+    return -1;
+  }
+  return 0;
+}
+
+static PyObject* atomicreferencearray_new(
+    PyTypeObject* type,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"size", "initial", NULL};
+  Py_ssize_t size = 0;
+  PyObject* initial = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "n|O", kwlist, &size, &initial)) {
+    return NULL;
+  }
+
+  if (size < 0) {
+    PyErr_SetString(PyExc_ValueError, "size must be non-negative");
+    return NULL;
+  }
+
+  AtomicReferenceArrayObject* self =
+      (AtomicReferenceArrayObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+
+  self->size = size;
+  self->weakreflist = NULL;
+  self->slots = PyMem_Malloc((size_t)size * sizeof(PyObject*));
+  if (self->slots == NULL && size > 0) {
+    Py_DECREF(self);
+    PyErr_NoMemory();
+    return NULL;
+  }
+
+  ConcurrentRegisterReference(initial);
+  for (Py_ssize_t index = 0; index < size; index++) {
+    self->slots[index] = Py_NewRef(initial);
+  }
+
+  return (PyObject*)self;
+}
+
+static int atomicreferencearray_clear(AtomicReferenceArrayObject* self) {
+  if (self->slots != NULL) {
+    for (Py_ssize_t index = 0; index < self->size; index++) {
+      Py_CLEAR(self->slots[index]);
+    }
+  }
+  return 0;
+}
+
+static void atomicreferencearray_dealloc(AtomicReferenceArrayObject* self) {
+  PyObject_GC_UnTrack(self);
+  atomicreferencearray_clear(self);
+  PyMem_Free(self->slots);
+  PyObject_ClearWeakRefs((PyObject*)self);
+  PyObject_GC_Del(self);
+}
+
+static int atomicreferencearray_traverse(
+    AtomicReferenceArrayObject* self,
+    visitproc visit,
+    void* arg) {
+  if (self->slots != NULL) {
+    for (Py_ssize_t index = 0; index < self->size; index++) {
+      Py_VISIT(_Py_atomic_load_ptr(&self->slots[index]));
+    }
+  }
+  return 0;
+}
+
+static PyObject* atomicreferencearray_get(
+    AtomicReferenceArrayObject* self,
+    PyObject* arg) {
+  Py_ssize_t index = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+  if (index == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return NULL;
+  }
+  return ConcurrentGetNewReference(&self->slots[index]);
+}
+
+static PyObject* atomicreferencearray_set(
+    AtomicReferenceArrayObject* self,
+    PyObject* args) {
+  Py_ssize_t index;
+  PyObject* obj;
+  if (!PyArg_ParseTuple(args, "nO", &index, &obj)) {
+    return NULL;
+  }
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return NULL;
+  }
+  ConcurrentRegisterReference(obj);
+  Py_INCREF(obj);
+  PyObject* ret = _Py_atomic_exchange_ptr(&self->slots[index], obj);
+  Py_DECREF(ret);
+  Py_RETURN_NONE;
+}
+
+static PyObject* atomicreferencearray_exchange(
+    AtomicReferenceArrayObject* self,
+    PyObject* args) {
+  Py_ssize_t index;
+  PyObject* obj;
+  if (!PyArg_ParseTuple(args, "nO", &index, &obj)) {
+    return NULL;
+  }
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return NULL;
+  }
+  ConcurrentRegisterReference(obj);
+  Py_INCREF(obj);
+  return _Py_atomic_exchange_ptr(&self->slots[index], obj);
+}
+
+static PyObject* atomicreferencearray_compare_exchange(
+    AtomicReferenceArrayObject* self,
+    PyObject* args) {
+  Py_ssize_t index;
+  PyObject* expected;
+  PyObject* obj;
+  if (!PyArg_ParseTuple(args, "nOO", &index, &expected, &obj)) {
+    return NULL;
+  }
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return NULL;
+  }
+  ConcurrentRegisterReference(obj);
+  Py_INCREF(obj);
+  if (!_Py_atomic_compare_exchange_ptr(&self->slots[index], &expected, obj)) {
+    Py_DECREF(obj);
+    Py_RETURN_FALSE;
+  }
+  Py_DECREF(expected);
+  Py_RETURN_TRUE;
+}
+
+/* Copy the slots into a plain list. Each slot read is atomic but the list is
+ * not a point-in-time snapshot of the whole array.
+ */
+static PyObject* atomicreferencearray_to_list(AtomicReferenceArrayObject* self) {
+  PyObject* result = PyList_New(self->size);
+  if (result == NULL) {
+    return NULL;
+  }
+  for (Py_ssize_t index = 0; index < self->size; index++) {
+    PyObject* value = ConcurrentGetNewReference(&self->slots[index]);
+    PyList_SET_ITEM(result, index, value);
+  }
+  return result;
+}
+
+static Py_ssize_t atomicreferencearray_len(AtomicReferenceArrayObject* self) {
+  return self->size;
+}
+
+static PyObject* atomicreferencearray_item(
+    AtomicReferenceArrayObject* self,
+    Py_ssize_t index) {
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return NULL;
+  }
+  return ConcurrentGetNewReference(&self->slots[index]);
+}
+
+static int atomicreferencearray_ass_item(
+    AtomicReferenceArrayObject* self,
+    Py_ssize_t index,
+    PyObject* obj) {
+  if (atomicreferencearray_check_index(self, index) < 0) {
+    return -1;
+  }
+  if (obj == NULL) {
+    PyErr_SetString(
+        PyExc_TypeError, "AtomicReferenceArray does not support deletion");
+    return -1;
+  }
+  ConcurrentRegisterReference(obj);
+  Py_INCREF(obj);
+  PyObject* ret = _Py_atomic_exchange_ptr(&self->slots[index], obj);
+  Py_DECREF(ret);
+  return 0;
+}
+
+static PyMethodDef AtomicReferenceArray_methods[] = {
+    {"get",
+     (PyCFunction)atomicreferencearray_get,
+     METH_O,
+     PyDoc_STR("get(index) -> object. Atomically read the slot.")},
+    {"set",
+     (PyCFunction)atomicreferencearray_set,
+     METH_VARARGS,
+     PyDoc_STR("set(index, value) -> None. Atomically replace the slot.")},
+    {"exchange",
+     (PyCFunction)atomicreferencearray_exchange,
+     METH_VARARGS,
+     PyDoc_STR(
+         "exchange(index, value) -> object. Atomically replace the slot "
+         "and return the previous value.")},
+    {"compare_exchange",
+     (PyCFunction)atomicreferencearray_compare_exchange,
+     METH_VARARGS,
+     PyDoc_STR(
+         "compare_exchange(index, expected, value) -> bool. Replace the "
+         "slot with value only if it holds expected (by identity).")},
+    {"to_list",
+     (PyCFunction)atomicreferencearray_to_list,
+     METH_NOARGS,
+     PyDoc_STR("to_list() -> list. Copy the slots into a plain list.")},
+    {NULL}};
+
+static PySequenceMethods AtomicReferenceArray_as_sequence = {
+    .sq_length = (lenfunc)atomicreferencearray_len,
+    .sq_item = (ssizeargfunc)atomicreferencearray_item,
+    .sq_ass_item = (ssizeobjargproc)atomicreferencearray_ass_item,
+};
+
+PyTypeObject AtomicReferenceArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name =
+        "_concurrency.AtomicReferenceArray",
+    .tp_basicsize = sizeof(AtomicReferenceArrayObject),
+    .tp_dealloc = (destructor)atomicreferencearray_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc =
+        "AtomicReferenceArray(size, initial=None)\n"
+        "--\n"
+        "\n"
+        "A fixed-size array of atomically-updatable object slots held in\n"
+        "one contiguous allocation. Each slot supports the AtomicReference\n"
+        "operations; indexing reads and writes are atomic per slot.",
+    .tp_traverse = (traverseproc)atomicreferencearray_traverse,
+    .tp_clear = (inquiry)atomicreferencearray_clear,
+    .tp_methods = AtomicReferenceArray_methods,
+    .tp_as_sequence = &AtomicReferenceArray_as_sequence,
+    .tp_new = atomicreferencearray_new,
+    .tp_weaklistoffset = offsetof(AtomicReferenceArrayObject, weakreflist),
+};
@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef ATOMIC_REFERENCE_ARRAY_H
+#define ATOMIC_REFERENCE_ARRAY_H
+
+#include <Python.h>
+
+extern PyTypeObject AtomicReferenceArrayType;
+
+#endif /* ATOMIC_REFERENCE_ARRAY_H */
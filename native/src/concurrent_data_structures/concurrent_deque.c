@@ -4,24 +4,43 @@
 
 #include "concurrent_deque.h"
 
-/* A node represents a single datum in the deque. It is a doubly-linked list
- * node that contains a pointer to the datum.
+/* The number of datum slots held by a single node. Items are stored in
+ * contiguous blocks of this size so that indexing and iteration chase one
+ * pointer per block rather than one per item.
+ */
+#define CONCURRENT_DEQUE_BLOCK_SIZE 64
+
+/* A node represents a block of data in the deque. It is a doubly-linked list
+ * node that contains a fixed-size array of datum slots, of which the slots in
+ * the half-open range [left, right) are occupied. Blocks in a live list are
+ * never empty; a block whose last item is removed is unlinked instead.
  */
 typedef struct ConcurrentDequeNode {
   struct ConcurrentDequeNode* prev;
   struct ConcurrentDequeNode* next;
-  PyObject* datum;
+  Py_ssize_t left;
+  Py_ssize_t right;
+  PyObject* data[CONCURRENT_DEQUE_BLOCK_SIZE];
 } ConcurrentDequeNode;
 
 /* A list represents the bounds of the deque. We allocate it in a separate
  * object to allow it to be replaced atomically from within the deque, allowing
- * these objects to be used concurrently.
+ * these objects to be used concurrently. The total number of items is cached
+ * here so that len() does not need to walk the blocks.
  */
 typedef struct {
   ConcurrentDequeNode* head;
   ConcurrentDequeNode* tail;
+  Py_ssize_t length;
 } ConcurrentDequeList;
 
+/* The number of recycled nodes and recycled lists a deque holds on to. A
+ * producer/consumer pair ping-pongs one node per block of items and one list
+ * per operation, so a handful of slots is enough to make steady-state churn
+ * allocator-free while keeping the retained memory bounded.
+ */
+#define CONCURRENT_DEQUE_POOL_SLOTS 8
+
 /* A deque is a doubly-sided queue that is optimized for adding and removing
  * items at the ends. It maintains a list object that contains a pointer to its
  * head and tail nodes.
@@ -37,39 +56,148 @@ typedef struct {
    */
   PyObject_HEAD ConcurrentDequeList* list;
   PyObject* weakreflist;
+  /* Free pools of nodes and lists retired by earlier operations. Each slot
+   * holds either NULL or one free object and is claimed or filled with a
+   * single atomic exchange, so unlike a linked freelist there is no ABA
+   * window and no lock. Misses simply fall through to the allocator.
+   */
+  ConcurrentDequeNode* node_pool[CONCURRENT_DEQUE_POOL_SLOTS];
+  ConcurrentDequeList* list_pool[CONCURRENT_DEQUE_POOL_SLOTS];
 } ConcurrentDequeObject;
 
-/* Allocate a new node for the deque and return a pointer to it.
+/* Take a recycled node out of the deque's pool, or NULL on a miss.
  */
-static ConcurrentDequeNode* ConcurrentDequeNode_alloc(
-    PyObject* datum,
+static ConcurrentDequeNode* ConcurrentDeque_node_take(
+    ConcurrentDequeObject* self) {
+  for (Py_ssize_t slot = 0; slot < CONCURRENT_DEQUE_POOL_SLOTS; slot++) {
+    ConcurrentDequeNode* node =
+        _Py_atomic_exchange_ptr(&self->node_pool[slot], NULL);
+    if (node != NULL) {
+      return node;
+    }
+  }
+  return NULL;
+}
+
+/* Hand a retired node to the deque's pool, freeing it if the pool is full.
+ * The caller must hold the only reference to the node and any data slot
+ * references must already have been handed over or released.
+ */
+static void ConcurrentDeque_node_recycle(
+    ConcurrentDequeObject* self,
+    ConcurrentDequeNode* node) {
+  for (Py_ssize_t slot = 0; slot < CONCURRENT_DEQUE_POOL_SLOTS; slot++) {
+    void* expected = NULL;
+    if (_Py_atomic_compare_exchange_ptr(
+            &self->node_pool[slot], &expected, node)) {
+      return;
+    }
+  }
+  PyMem_Free(node);
+}
+
+/* Take a recycled list out of the deque's pool, or NULL on a miss.
+ */
+static ConcurrentDequeList* ConcurrentDeque_list_take(
+    ConcurrentDequeObject* self) {
+  for (Py_ssize_t slot = 0; slot < CONCURRENT_DEQUE_POOL_SLOTS; slot++) {
+    ConcurrentDequeList* list =
+        _Py_atomic_exchange_ptr(&self->list_pool[slot], NULL);
+    if (list != NULL) {
+      return list;
+    }
+  }
+  return NULL;
+}
+
+/* Hand a retired list to the deque's pool, freeing it if the pool is full.
+ */
+static void ConcurrentDeque_list_recycle(
+    ConcurrentDequeObject* self,
+    ConcurrentDequeList* list) {
+  for (Py_ssize_t slot = 0; slot < CONCURRENT_DEQUE_POOL_SLOTS; slot++) {
+    void* expected = NULL;
+    if (_Py_atomic_compare_exchange_ptr(
+            &self->list_pool[slot], &expected, list)) {
+      return;
+    }
+  }
+  PyMem_Free(list);
+}
+
+/* Free everything held by the pools. Only called when the deque is being
+ * deallocated, so no other thread can be exchanging slots.
+ */
+static void ConcurrentDeque_drain_pools(ConcurrentDequeObject* self) {
+  for (Py_ssize_t slot = 0; slot < CONCURRENT_DEQUE_POOL_SLOTS; slot++) {
+    PyMem_Free(self->node_pool[slot]);
+    self->node_pool[slot] = NULL;
+    PyMem_Free(self->list_pool[slot]);
+    self->list_pool[slot] = NULL;
+  }
+}
+
+/* Allocate a new empty block for the deque, recycling a pooled one when
+ * available, and return a pointer to it.
+ */
+static ConcurrentDequeNode* ConcurrentDequeNode_alloc_empty(
+    ConcurrentDequeObject* deque,
     ConcurrentDequeNode* prev,
     ConcurrentDequeNode* next) {
-  ConcurrentDequeNode* node = PyMem_Malloc(sizeof(ConcurrentDequeNode));
+  ConcurrentDequeNode* node = ConcurrentDeque_node_take(deque);
   if (node == NULL) {
-    PyErr_NoMemory();
-    return NULL;
+    node = PyMem_Malloc(sizeof(ConcurrentDequeNode));
+    if (node == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+    }
   }
 
   node->prev = prev;
   node->next = next;
+  node->left = 0;
+  node->right = 0;
+
+  return node;
+}
+
+/* Allocate a new block holding a single datum at the given slot position.
+ * Appends place the datum in the leftmost slot so that further appends fill
+ * rightward, and prepends place it in the rightmost slot for the mirrored
+ * reason.
+ */
+static ConcurrentDequeNode* ConcurrentDequeNode_alloc(
+    ConcurrentDequeObject* deque,
+    PyObject* datum,
+    ConcurrentDequeNode* prev,
+    ConcurrentDequeNode* next,
+    Py_ssize_t position) {
+  ConcurrentDequeNode* node = ConcurrentDequeNode_alloc_empty(deque, prev, next);
+  if (node == NULL) {
+    return NULL;
+  }
+
+  node->left = position;
+  node->right = position + 1;
 
   Py_INCREF(datum);
-  node->datum = datum;
+  node->data[position] = datum;
 
   return node;
 }
 
 /* Deallocate a node object, using Python's memory management. We have this here
  * to signify to the reader that we know we're only freeing the node and
- * purposefully not decrementing the reference count of the datum.
+ * purposefully not decrementing the reference counts of the data.
  */
 #define ConcurrentDequeNode_dealloc_shallow PyMem_Free
 
-/* Deallocate a node and remove its reference to the datum.
+/* Deallocate a node and remove its references to the occupied data slots.
  */
 static void ConcurrentDequeNode_dealloc(ConcurrentDequeNode* node) {
-  Py_DECREF(node->datum);
+  for (Py_ssize_t slot = node->left; slot < node->right; slot++) {
+    Py_DECREF(node->data[slot]);
+  }
   ConcurrentDequeNode_dealloc_shallow(node);
 }
 
@@ -84,19 +212,25 @@ static void ConcurrentDequeNode_dealloc_chain(ConcurrentDequeNode* node) {
 }
 
 /* Allocate the internal list object that is used by the deque to hold its
- * contents.
+ * contents, recycling a pooled one when available.
  */
 static ConcurrentDequeList* ConcurrentDequeList_alloc(
+    ConcurrentDequeObject* deque,
     ConcurrentDequeNode* head,
-    ConcurrentDequeNode* tail) {
-  ConcurrentDequeList* list = PyMem_Malloc(sizeof(ConcurrentDequeList));
+    ConcurrentDequeNode* tail,
+    Py_ssize_t length) {
+  ConcurrentDequeList* list = ConcurrentDeque_list_take(deque);
   if (list == NULL) {
-    PyErr_NoMemory();
-    return NULL;
+    list = PyMem_Malloc(sizeof(ConcurrentDequeList));
+    if (list == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+    }
   }
 
   list->head = head;
   list->tail = tail;
+  list->length = length;
   return list;
 }
 
@@ -197,8 +331,8 @@ static int ConcurrentDeque_clear(ConcurrentDequeObject* self) {
   }
 }
 
-/* Provide the traverse implementation for the GC. Visit each node in the linked
- * list if a list has been allocated.
+/* Provide the traverse implementation for the GC. Visit each occupied slot in
+ * the linked list of blocks if a list has been allocated.
  */
 static int ConcurrentDeque_traverse(
     ConcurrentDequeObject* self,
@@ -211,7 +345,9 @@ static int ConcurrentDeque_traverse(
 
   for (ConcurrentDequeNode* node = list->head; node != NULL;
        node = node->next) {
-    Py_VISIT(node->datum);
+    for (Py_ssize_t slot = node->left; slot < node->right; slot++) {
+      Py_VISIT(node->data[slot]);
+    }
   }
   return 0;
 }
@@ -230,6 +366,8 @@ ConcurrentDeque_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
 
   deque->list = NULL;
   deque->weakreflist = NULL;
+  memset(deque->node_pool, 0, sizeof(deque->node_pool));
+  memset(deque->list_pool, 0, sizeof(deque->list_pool));
 
   return (PyObject*)deque;
 }
@@ -281,6 +419,7 @@ static void ConcurrentDeque_dealloc(ConcurrentDequeObject* self) {
   }
 
   ConcurrentDeque_clear(self);
+  ConcurrentDeque_drain_pools(self);
   tp->tp_free(self);
 }
 
@@ -296,14 +435,15 @@ PyDoc_STRVAR(
 static PyObject* ConcurrentDeque_append(
     ConcurrentDequeObject* self,
     PyObject* datum) {
-  ConcurrentDequeNode* next_node = ConcurrentDequeNode_alloc(datum, NULL, NULL);
+  ConcurrentDequeNode* next_node =
+      ConcurrentDequeNode_alloc(self, datum, NULL, NULL, 0);
 
   if (next_node == NULL) {
     return NULL;
   }
 
   ConcurrentDequeList* next_list =
-      ConcurrentDequeList_alloc(next_node, next_node);
+      ConcurrentDequeList_alloc(self, next_node, next_node, 1);
 
   if (next_list == NULL) {
     ConcurrentDequeNode_dealloc(next_node);
@@ -323,16 +463,37 @@ static PyObject* ConcurrentDeque_append(
         Py_RETURN_NONE;
       }
     } else if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
-      /* Otherwise, we will attempt to append the item to the end of the current
-       * list by replacing the tail of the current list.
+      ConcurrentDequeNode* tail = list->tail;
+
+      if (tail->right < CONCURRENT_DEQUE_BLOCK_SIZE) {
+        /* The tail block has a free slot, so we store the item there and hand
+         * the reference held by our pre-allocated node over to the block.
+         */
+        tail->data[tail->right] = datum;
+        tail->right += 1;
+
+        next_list->head = list->head;
+        next_list->tail = list->tail;
+        next_list->length = list->length + 1;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_node_recycle(self, next_node);
+        ConcurrentDeque_list_recycle(self, list);
+        Py_RETURN_NONE;
+      }
+
+      /* Otherwise, the tail block is full, so we link our pre-allocated node
+       * in as the new tail of the list.
        */
       next_list->head = list->head;
+      next_list->length = list->length + 1;
       next_node->prev = list->tail;
       next_node->prev->next = next_node;
 
       ConcurrentDeque_replace(self, next_list);
 
-      ConcurrentDequeList_dealloc_shallow(list);
+      ConcurrentDeque_list_recycle(self, list);
       Py_RETURN_NONE;
     }
   }
@@ -350,14 +511,15 @@ PyDoc_STRVAR(
 static PyObject* ConcurrentDeque_appendleft(
     ConcurrentDequeObject* self,
     PyObject* datum) {
-  ConcurrentDequeNode* next_node = ConcurrentDequeNode_alloc(datum, NULL, NULL);
+  ConcurrentDequeNode* next_node = ConcurrentDequeNode_alloc(
+      self, datum, NULL, NULL, CONCURRENT_DEQUE_BLOCK_SIZE - 1);
 
   if (next_node == NULL) {
     return NULL;
   }
 
   ConcurrentDequeList* next_list =
-      ConcurrentDequeList_alloc(next_node, next_node);
+      ConcurrentDequeList_alloc(self, next_node, next_node, 1);
 
   if (next_list == NULL) {
     ConcurrentDequeNode_dealloc(next_node);
@@ -377,16 +539,37 @@ static PyObject* ConcurrentDeque_appendleft(
         Py_RETURN_NONE;
       }
     } else if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
-      /* Otherwise, we will attempt to append the item to the start of the
-       * current list by replacing the head of the current list.
+      ConcurrentDequeNode* head = list->head;
+
+      if (head->left > 0) {
+        /* The head block has a free slot, so we store the item there and hand
+         * the reference held by our pre-allocated node over to the block.
+         */
+        head->left -= 1;
+        head->data[head->left] = datum;
+
+        next_list->head = list->head;
+        next_list->tail = list->tail;
+        next_list->length = list->length + 1;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_node_recycle(self, next_node);
+        ConcurrentDeque_list_recycle(self, list);
+        Py_RETURN_NONE;
+      }
+
+      /* Otherwise, the head block is full, so we link our pre-allocated node
+       * in as the new head of the list.
        */
       next_list->tail = list->tail;
+      next_list->length = list->length + 1;
       next_node->next = list->head;
       next_node->next->prev = next_node;
 
       ConcurrentDeque_replace(self, next_list);
 
-      ConcurrentDequeList_dealloc_shallow(list);
+      ConcurrentDeque_list_recycle(self, list);
       Py_RETURN_NONE;
     }
   }
@@ -410,9 +593,12 @@ static PyObject* ConcurrentDeque_clearmethod(ConcurrentDequeObject* self) {
 #define _ConcurrentDequeList_fromiter_BACKWARD 1
 
 /* A helper for extend and extendleft that creates a new list from an iterable
- * python object.
+ * python object. Items are packed into blocks as they arrive: forward
+ * construction fills each block rightward and chains at the tail, and backward
+ * construction fills leftward and chains at the head.
  */
 static ConcurrentDequeList* _ConcurrentDequeList_fromiter(
+    ConcurrentDequeObject* deque,
     PyObject* iter,
     int ordering) {
   PyObject* datum;
@@ -420,46 +606,68 @@ static ConcurrentDequeList* _ConcurrentDequeList_fromiter(
 
   ConcurrentDequeNode* head = NULL;
   ConcurrentDequeNode* tail = NULL;
+  Py_ssize_t length = 0;
 
   while ((datum = iternext(iter)) != NULL) {
-    ConcurrentDequeNode* next = ConcurrentDequeNode_alloc(datum, NULL, NULL);
+    if (ordering == _ConcurrentDequeList_fromiter_FORWARD) {
+      if (tail == NULL || tail->right == CONCURRENT_DEQUE_BLOCK_SIZE) {
+        ConcurrentDequeNode* next = ConcurrentDequeNode_alloc_empty(deque, tail, NULL);
 
-    if (next == NULL) {
-      ConcurrentDequeNode_dealloc_chain(head);
-      Py_DECREF(datum);
-      Py_DECREF(iter);
-      return NULL;
-    }
+        if (next == NULL) {
+          ConcurrentDequeNode_dealloc_chain(head);
+          Py_DECREF(datum);
+          Py_DECREF(iter);
+          return NULL;
+        }
 
-    if (ordering == _ConcurrentDequeList_fromiter_FORWARD) {
-      next->prev = tail;
+        if (head == NULL) {
+          head = next;
+        } else {
+          tail->next = next;
+        }
 
-      if (head == NULL) {
-        head = next;
-      } else {
-        tail->next = next;
+        tail = next;
       }
 
-      tail = next;
+      /* The reference returned by the iterator is handed to the block. */
+      tail->data[tail->right] = datum;
+      tail->right += 1;
     } else {
-      next->next = head;
+      if (head == NULL || head->left == 0) {
+        ConcurrentDequeNode* next = ConcurrentDequeNode_alloc_empty(deque, NULL, head);
 
-      if (tail == NULL) {
-        tail = next;
-      } else {
-        head->prev = next;
+        if (next == NULL) {
+          ConcurrentDequeNode_dealloc_chain(head);
+          Py_DECREF(datum);
+          Py_DECREF(iter);
+          return NULL;
+        }
+
+        next->left = CONCURRENT_DEQUE_BLOCK_SIZE;
+        next->right = CONCURRENT_DEQUE_BLOCK_SIZE;
+
+        if (tail == NULL) {
+          tail = next;
+        } else {
+          head->prev = next;
+        }
+
+        head = next;
       }
 
-      head = next;
+      /* The reference returned by the iterator is handed to the block. */
+      head->left -= 1;
+      head->data[head->left] = datum;
     }
 
-    Py_DECREF(datum);
+    ++length;
   }
 
   if (PyErr_Occurred()) {
     if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
       PyErr_Clear();
     } else {
+      ConcurrentDequeNode_dealloc_chain(head);
       Py_DECREF(iter);
       return NULL;
     }
@@ -468,22 +676,31 @@ static ConcurrentDequeList* _ConcurrentDequeList_fromiter(
   ConcurrentDequeList* list = NULL;
 
   if (head != NULL) {
-    list = ConcurrentDequeList_alloc(head, tail);
+    list = ConcurrentDequeList_alloc(deque, head, tail, length);
 
     if (list == NULL) {
       ConcurrentDequeNode_dealloc_chain(head);
       Py_DECREF(iter);
       return NULL;
     }
-
-    list->head = head;
-    list->tail = tail;
   }
 
   Py_DECREF(iter);
   return list;
 }
 
+/* Register every datum held by a not yet published list so the values can
+ * take part in the concurrent API once readers can reach them. One batch
+ * call per block amortizes the per-object cost on bulk loads.
+ */
+static void _ConcurrentDequeList_register(ConcurrentDequeList* list) {
+  for (ConcurrentDequeNode* node = list->head; node != NULL;
+       node = node->next) {
+    ConcurrentRegisterReferenceBatch(
+        node->data + node->left, node->right - node->left);
+  }
+}
+
 PyDoc_STRVAR(
     ConcurrentDeque_extend__doc__,
     "extend($self, iterable, /)\n"
@@ -513,7 +730,7 @@ static PyObject* ConcurrentDeque_extend(
   }
 
   ConcurrentDequeList* next_list = _ConcurrentDequeList_fromiter(
-      iter, _ConcurrentDequeList_fromiter_FORWARD);
+      self, iter, _ConcurrentDequeList_fromiter_FORWARD);
 
   if (PyErr_Occurred()) {
     return NULL;
@@ -521,6 +738,8 @@ static PyObject* ConcurrentDeque_extend(
     Py_RETURN_NONE;
   }
 
+  _ConcurrentDequeList_register(next_list);
+
   ConcurrentDequeNode* head = next_list->head;
   ConcurrentDequeList* next_list_locked = ConcurrentDequeList_locked(next_list);
 
@@ -533,12 +752,13 @@ static PyObject* ConcurrentDeque_extend(
       }
     } else if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
       next_list->head = list->head;
+      next_list->length += list->length;
       head->prev = list->tail;
       head->prev->next = head;
 
       ConcurrentDeque_replace(self, next_list);
 
-      ConcurrentDequeList_dealloc_shallow(list);
+      ConcurrentDeque_list_recycle(self, list);
       Py_RETURN_NONE;
     }
   }
@@ -573,7 +793,7 @@ static PyObject* ConcurrentDeque_extendleft(
   }
 
   ConcurrentDequeList* next_list = _ConcurrentDequeList_fromiter(
-      iter, _ConcurrentDequeList_fromiter_BACKWARD);
+      self, iter, _ConcurrentDequeList_fromiter_BACKWARD);
 
   if (PyErr_Occurred()) {
     return NULL;
@@ -581,6 +801,8 @@ static PyObject* ConcurrentDeque_extendleft(
     Py_RETURN_NONE;
   }
 
+  _ConcurrentDequeList_register(next_list);
+
   ConcurrentDequeNode* tail = next_list->tail;
   ConcurrentDequeList* next_list_locked = ConcurrentDequeList_locked(next_list);
 
@@ -593,12 +815,13 @@ static PyObject* ConcurrentDeque_extendleft(
       }
     } else if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
       next_list->tail = list->tail;
+      next_list->length += list->length;
       tail->next = list->head;
       tail->next->prev = tail;
 
       ConcurrentDeque_replace(self, next_list);
 
-      ConcurrentDequeList_dealloc_shallow(list);
+      ConcurrentDeque_list_recycle(self, list);
       Py_RETURN_NONE;
     }
   }
@@ -614,7 +837,7 @@ PyDoc_STRVAR(
 /* Remove and return the rightmost element.
  */
 static PyObject* ConcurrentDeque_pop(ConcurrentDequeObject* self) {
-  ConcurrentDequeList* next_list = ConcurrentDequeList_alloc(NULL, NULL);
+  ConcurrentDequeList* next_list = ConcurrentDequeList_alloc(self, NULL, NULL, 0);
 
   if (next_list == NULL) {
     return NULL;
@@ -627,32 +850,50 @@ static PyObject* ConcurrentDeque_pop(ConcurrentDequeObject* self) {
 
     if (list == NULL) {
       PyErr_SetString(PyExc_RuntimeError, "pop from an empty ConcurrentDeque");
-      ConcurrentDequeList_dealloc_shallow(next_list);
+      ConcurrentDeque_list_recycle(self, next_list);
       return NULL;
     }
 
     if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
       ConcurrentDequeNode* tail = list->tail;
+      PyObject* datum = tail->data[tail->right - 1];
+
+      if (tail->right - tail->left > 1) {
+        /* The tail block holds more items, so we simply shrink it. The slot's
+         * reference is handed to the caller.
+         */
+        tail->right -= 1;
+
+        next_list->head = list->head;
+        next_list->tail = list->tail;
+        next_list->length = list->length - 1;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_list_recycle(self, list);
+        return datum;
+      }
+
       ConcurrentDequeNode* prev = tail->prev;
-      PyObject* datum = tail->datum;
 
       if (prev == NULL) {
         ConcurrentDeque_replace(self, NULL);
 
-        ConcurrentDequeNode_dealloc_shallow(tail);
-        ConcurrentDequeList_dealloc_shallow(list);
-        ConcurrentDequeList_dealloc_shallow(next_list);
+        ConcurrentDeque_node_recycle(self, tail);
+        ConcurrentDeque_list_recycle(self, list);
+        ConcurrentDeque_list_recycle(self, next_list);
 
         return datum;
       } else {
         next_list->head = list->head;
         next_list->tail = prev;
+        next_list->length = list->length - 1;
         prev->next = NULL;
 
         ConcurrentDeque_replace(self, next_list);
 
-        ConcurrentDequeNode_dealloc_shallow(tail);
-        ConcurrentDequeList_dealloc_shallow(list);
+        ConcurrentDeque_node_recycle(self, tail);
+        ConcurrentDeque_list_recycle(self, list);
 
         return datum;
       }
@@ -670,7 +911,7 @@ PyDoc_STRVAR(
 /* Remove and return the leftmost element.
  */
 static PyObject* ConcurrentDeque_popleft(ConcurrentDequeObject* self) {
-  ConcurrentDequeList* next_list = ConcurrentDequeList_alloc(NULL, NULL);
+  ConcurrentDequeList* next_list = ConcurrentDequeList_alloc(self, NULL, NULL, 0);
 
   if (next_list == NULL) {
     return NULL;
@@ -683,32 +924,136 @@ static PyObject* ConcurrentDeque_popleft(ConcurrentDequeObject* self) {
 
     if (list == NULL) {
       PyErr_SetString(PyExc_RuntimeError, "pop from an empty ConcurrentDeque");
-      ConcurrentDequeList_dealloc_shallow(next_list);
+      ConcurrentDeque_list_recycle(self, next_list);
       return NULL;
     }
 
     if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
       ConcurrentDequeNode* head = list->head;
+      PyObject* datum = head->data[head->left];
+
+      if (head->right - head->left > 1) {
+        /* The head block holds more items, so we simply shrink it. The slot's
+         * reference is handed to the caller.
+         */
+        head->left += 1;
+
+        next_list->head = list->head;
+        next_list->tail = list->tail;
+        next_list->length = list->length - 1;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_list_recycle(self, list);
+        return datum;
+      }
+
       ConcurrentDequeNode* next = head->next;
-      PyObject* datum = head->datum;
 
       if (next == NULL) {
         ConcurrentDeque_replace(self, NULL);
 
-        ConcurrentDequeNode_dealloc_shallow(head);
-        ConcurrentDequeList_dealloc_shallow(list);
-        ConcurrentDequeList_dealloc_shallow(next_list);
+        ConcurrentDeque_node_recycle(self, head);
+        ConcurrentDeque_list_recycle(self, list);
+        ConcurrentDeque_list_recycle(self, next_list);
 
         return datum;
       } else {
         next_list->head = next;
         next_list->tail = list->tail;
+        next_list->length = list->length - 1;
         next->prev = NULL;
 
         ConcurrentDeque_replace(self, next_list);
 
-        ConcurrentDequeNode_dealloc_shallow(head);
-        ConcurrentDequeList_dealloc_shallow(list);
+        ConcurrentDeque_node_recycle(self, head);
+        ConcurrentDeque_list_recycle(self, list);
+
+        return datum;
+      }
+    }
+  }
+}
+
+PyDoc_STRVAR(
+    ConcurrentDeque_pop_steal__doc__,
+    "pop_steal($self, default=None, /)\n"
+    "--\n"
+    "\n"
+    "Remove and return the leftmost element, or default when empty.\n"
+    "\n"
+    "Intended for work-stealing schedulers where an owner thread works the\n"
+    "right end with append()/pop() and thief threads take from the left:\n"
+    "an empty deque is the common case for a thief, so it is reported by\n"
+    "value rather than paying to raise and catch an exception.");
+
+/* Remove and return the leftmost element, or default_value when empty.
+ */
+static PyObject* ConcurrentDeque_pop_steal(
+    ConcurrentDequeObject* self,
+    PyObject* args) {
+  PyObject* default_value = Py_None;
+
+  if (!PyArg_ParseTuple(args, "|O", &default_value)) {
+    return NULL;
+  }
+
+  ConcurrentDequeList* next_list = ConcurrentDequeList_alloc(self, NULL, NULL, 0);
+
+  if (next_list == NULL) {
+    return NULL;
+  }
+
+  ConcurrentDequeList* next_list_locked = ConcurrentDequeList_locked(next_list);
+
+  ConcurrentDeque_backoff_loop {
+    ConcurrentDequeList* list = ConcurrentDeque_list(self);
+
+    if (list == NULL) {
+      ConcurrentDeque_list_recycle(self, next_list);
+      return Py_NewRef(default_value);
+    }
+
+    if (ConcurrentDeque_try_replace(self, &list, next_list_locked)) {
+      ConcurrentDequeNode* head = list->head;
+      PyObject* datum = head->data[head->left];
+
+      if (head->right - head->left > 1) {
+        /* The head block holds more items, so we simply shrink it. The slot's
+         * reference is handed to the caller.
+         */
+        head->left += 1;
+
+        next_list->head = list->head;
+        next_list->tail = list->tail;
+        next_list->length = list->length - 1;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_list_recycle(self, list);
+        return datum;
+      }
+
+      ConcurrentDequeNode* next = head->next;
+
+      if (next == NULL) {
+        ConcurrentDeque_replace(self, NULL);
+
+        ConcurrentDeque_node_recycle(self, head);
+        ConcurrentDeque_list_recycle(self, list);
+        ConcurrentDeque_list_recycle(self, next_list);
+
+        return datum;
+      } else {
+        next_list->head = next;
+        next_list->tail = list->tail;
+        next_list->length = list->length - 1;
+        next->prev = NULL;
+
+        ConcurrentDeque_replace(self, next_list);
+
+        ConcurrentDeque_node_recycle(self, head);
+        ConcurrentDeque_list_recycle(self, list);
 
         return datum;
       }
@@ -750,30 +1095,45 @@ static PyObject* ConcurrentDeque_remove(
   while (current != NULL) {
     next = current->next;
 
-    PyObject* datum = Py_NewRef(current->datum);
-    int cmp = PyObject_RichCompareBool(datum, value, Py_EQ);
+    for (Py_ssize_t slot = current->left; slot < current->right; slot++) {
+      PyObject* datum = Py_NewRef(current->data[slot]);
+      int cmp = PyObject_RichCompareBool(datum, value, Py_EQ);
 
-    Py_DECREF(datum);
-    if (PyErr_Occurred()) {
-      return NULL;
-    }
+      Py_DECREF(datum);
+      if (PyErr_Occurred()) {
+        return NULL;
+      }
+
+      if (cmp == 0) {
+        continue;
+      }
 
-    if (cmp != 0) {
-      /* Here we have found the value. We need to remove it from the list.
-       * The mannier in which we remove the value depends on its position in
-       * the list.
+      /* Here we have found the value. If the block holds other items we close
+       * the gap within the block, otherwise we unlink the block from the list.
        */
+      if (current->right - current->left > 1) {
+        memmove(
+            &current->data[slot],
+            &current->data[slot + 1],
+            (current->right - slot - 1) * sizeof(PyObject*));
+        current->right -= 1;
+        list->length -= 1;
+
+        Py_DECREF(datum);
+        Py_RETURN_NONE;
+      }
+
       if (current == list->head && current == list->tail) {
         /* Replacing the entire list. */
         ConcurrentDeque_replace(self, NULL);
 
-        ConcurrentDequeList_dealloc_shallow(list);
+        ConcurrentDeque_list_recycle(self, list);
         ConcurrentDequeNode_dealloc(current);
         Py_RETURN_NONE;
       } else if (current == list->head) {
         /* Replacing the head of the list. */
         ConcurrentDequeList* next_list =
-            ConcurrentDequeList_alloc(next, list->tail);
+            ConcurrentDequeList_alloc(self, next, list->tail, list->length - 1);
 
         if (next_list == NULL) {
           return NULL;
@@ -782,13 +1142,13 @@ static PyObject* ConcurrentDeque_remove(
         next->prev = NULL;
         ConcurrentDeque_replace(self, next_list);
 
-        ConcurrentDequeList_dealloc_shallow(list);
+        ConcurrentDeque_list_recycle(self, list);
         ConcurrentDequeNode_dealloc(current);
         Py_RETURN_NONE;
       } else if (current == list->tail) {
         /* Replacing the tail of the list. */
         ConcurrentDequeList* next_list =
-            ConcurrentDequeList_alloc(list->head, prev);
+            ConcurrentDequeList_alloc(self, list->head, prev, list->length - 1);
 
         if (next_list == NULL) {
           return NULL;
@@ -797,13 +1157,14 @@ static PyObject* ConcurrentDeque_remove(
         prev->next = NULL;
         ConcurrentDeque_replace(self, next_list);
 
-        ConcurrentDequeList_dealloc_shallow(list);
+        ConcurrentDeque_list_recycle(self, list);
         ConcurrentDequeNode_dealloc(current);
         Py_RETURN_NONE;
       } else {
         /* Replacing a node in the middle of the list. */
         prev->next = next;
         next->prev = prev;
+        list->length -= 1;
 
         ConcurrentDequeNode_dealloc(current);
         Py_RETURN_NONE;
@@ -814,15 +1175,11 @@ static PyObject* ConcurrentDeque_remove(
     current = next;
   }
 
-  if (current == NULL) {
-    PyErr_SetString(
-        PyExc_ValueError,
-        "ConcurrentDeque.remove(x): x not in ConcurrentDeque");
-
-    return NULL;
-  }
+  PyErr_SetString(
+      PyExc_ValueError,
+      "ConcurrentDeque.remove(x): x not in ConcurrentDeque");
 
-  Py_RETURN_NONE;
+  return NULL;
 }
 
 PyDoc_STRVAR(
@@ -909,8 +1266,8 @@ static PyObject* ConcurrentDeque_repr(ConcurrentDequeObject* self) {
   return result;
 }
 
-/* Return the length of the given ConcurrentDeque, which is stored as part of
- * the var object struct.
+/* Return the length of the given ConcurrentDeque, which is cached on the list
+ * object so it does not need to be recomputed.
  */
 static Py_ssize_t ConcurrentDeque_len(ConcurrentDequeObject* self) {
   ConcurrentDequeList* list = ConcurrentDeque_list(self);
@@ -918,17 +1275,12 @@ static Py_ssize_t ConcurrentDeque_len(ConcurrentDequeObject* self) {
     return 0;
   }
 
-  ConcurrentDequeNode* node;
-  Py_ssize_t length = 0;
-
-  for (node = list->head; node != NULL; node = node->next) {
-    ++length;
-  }
-
-  return length;
+  return list->length;
 }
 
-/* Returns the item at the specified index (counted from the left).
+/* Returns the item at the specified index (counted from the left). Whole
+ * blocks are skipped using their occupancy counts, so this costs one pointer
+ * chase per block rather than per item.
  */
 static PyObject* ConcurrentDeque_item(
     ConcurrentDequeObject* self,
@@ -945,17 +1297,18 @@ static PyObject* ConcurrentDeque_item(
     goto invalid;
   }
 
-  ConcurrentDequeNode* node = list->head;
-  for (Py_ssize_t i = 0; i < index && node != NULL; i++) {
-    node = node->next;
-  }
+  for (ConcurrentDequeNode* node = list->head; node != NULL;
+       node = node->next) {
+    Py_ssize_t count = node->right - node->left;
 
-  if (node == NULL) {
-    // If we didn't get to a node at the given index, then it is invalid.
-    goto invalid;
+    if (index < count) {
+      return Py_NewRef(node->data[node->left + index]);
+    }
+
+    index -= count;
   }
 
-  return Py_NewRef(node->datum);
+  // If we didn't get to a slot at the given index, then it is invalid.
 
 invalid:
   PyErr_SetString(PyExc_IndexError, "ConcurrentDeque index out of range");
@@ -974,16 +1327,18 @@ static int ConcurrentDeque_contains(
 
   for (ConcurrentDequeNode* node = list->head; node != NULL;
        node = node->next) {
-    PyObject* datum = Py_NewRef(node->datum);
-    int cmp = PyObject_RichCompareBool(datum, value, Py_EQ);
+    for (Py_ssize_t slot = node->left; slot < node->right; slot++) {
+      PyObject* datum = Py_NewRef(node->data[slot]);
+      int cmp = PyObject_RichCompareBool(datum, value, Py_EQ);
 
-    Py_DECREF(datum);
-    if (PyErr_Occurred()) {
-      return -1;
-    }
+      Py_DECREF(datum);
+      if (PyErr_Occurred()) {
+        return -1;
+      }
 
-    if (cmp != 0) {
-      return cmp;
+      if (cmp != 0) {
+        return cmp;
+      }
     }
   }
 
@@ -999,6 +1354,7 @@ static PyObject* ConcurrentDeque_richcompare(PyObject* v, PyObject* w, int op);
 typedef struct {
   PyObject_HEAD PyObject* deque;
   ConcurrentDequeNode* current;
+  Py_ssize_t slot;
   PyObject* weakreflist;
 } ConcurrentDequeIteratorObject;
 
@@ -1017,6 +1373,7 @@ static PyObject* ConcurrentDeque_iter(ConcurrentDequeObject* self) {
 
   ConcurrentDequeList* list = ConcurrentDeque_list(self);
   iterator->current = list == NULL ? NULL : list->head;
+  iterator->slot = iterator->current == NULL ? 0 : iterator->current->left;
 
   PyObject_GC_Track(iterator);
   return (PyObject*)iterator;
@@ -1062,8 +1419,13 @@ static PyObject* ConcurrentDequeIterator_next(
     return NULL;
   }
 
-  PyObject* datum = Py_NewRef(self->current->datum);
-  self->current = self->current->next;
+  PyObject* datum = Py_NewRef(self->current->data[self->slot]);
+
+  self->slot += 1;
+  if (self->slot >= self->current->right) {
+    self->current = self->current->next;
+    self->slot = self->current == NULL ? 0 : self->current->left;
+  }
 
   return datum;
 }
@@ -1110,6 +1472,10 @@ static PyMethodDef ConcurrentDeque_methods[] = {
      (PyCFunction)ConcurrentDeque_pop,
      METH_NOARGS,
      ConcurrentDeque_pop__doc__},
+    {"pop_steal",
+     (PyCFunction)ConcurrentDeque_pop_steal,
+     METH_VARARGS,
+     ConcurrentDeque_pop_steal__doc__},
     {"popleft",
      (PyCFunction)ConcurrentDeque_popleft,
      METH_NOARGS,
@@ -1249,3 +1615,35 @@ done:
     return NULL;
   }
 }
+
+/* C API entry points exported through the ft_utils capsule; see the
+   FTUtils_CAPI notes in ft_utils.h for the calling conventions. */
+
+int ConcurrentDeque_Push(PyObject* deque, PyObject* item) {
+  if (!PyObject_TypeCheck(deque, &ConcurrentDequeType)) {
+    PyErr_SetString(PyExc_TypeError, "expected a ConcurrentDeque");
+    return -1;
+  }
+  PyObject* none = ConcurrentDeque_append((ConcurrentDequeObject*)deque, item);
+  if (none == NULL) {
+    return -1;
+  }
+  Py_DECREF(none);
+  return 0;
+}
+
+PyObject* ConcurrentDeque_Pop(PyObject* deque) {
+  if (!PyObject_TypeCheck(deque, &ConcurrentDequeType)) {
+    PyErr_SetString(PyExc_TypeError, "expected a ConcurrentDeque");
+    return NULL;
+  }
+  return ConcurrentDeque_pop((ConcurrentDequeObject*)deque);
+}
+
+PyObject* ConcurrentDeque_PopLeft(PyObject* deque) {
+  if (!PyObject_TypeCheck(deque, &ConcurrentDequeType)) {
+    PyErr_SetString(PyExc_TypeError, "expected a ConcurrentDeque");
+    return NULL;
+  }
+  return ConcurrentDeque_popleft((ConcurrentDequeObject*)deque);
+}
@@ -8,4 +8,9 @@
 extern PyTypeObject ConcurrentDequeType;
 extern PyTypeObject ConcurrentDequeIteratorType;
 
+/* C API entry points exported through the ft_utils capsule. */
+int ConcurrentDeque_Push(PyObject* deque, PyObject* item);
+PyObject* ConcurrentDeque_Pop(PyObject* deque);
+PyObject* ConcurrentDeque_PopLeft(PyObject* deque);
+
 #endif /* CONCURRENT_DEQUE_H */
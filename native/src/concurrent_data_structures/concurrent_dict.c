@@ -4,45 +4,452 @@
 
 #include "concurrent_dict.h"
 
-typedef struct {
-  PyObject_HEAD PyObject** buckets;
+/* A shard table holds the bucket dicts. It is allocated as a separate object
+ * so a grow can publish a new table by swapping a single pointer, in the same
+ * way ConcurrentDeque swaps its list object.
+ */
+typedef struct ConcurrentDictTable {
   Py_ssize_t size;
+  PyObject** buckets;
+  /* Link in the owning dict's retired list once fully drained. */
+  struct ConcurrentDictTable* next_retired;
+} ConcurrentDictTable;
+
+typedef struct {
+  PyObject_HEAD ConcurrentDictTable* table;
+  /* Non-NULL only while a grow is in progress. Entries drain from old_table
+   * into table one bucket at a time (cooperative incremental rehash) rather
+   * than in one stop-the-world pass.
+   */
+  ConcurrentDictTable* old_table;
+  /* Fully drained tables. Keyed operations read table and bucket pointers
+   * without the grow mutex, so a drained table cannot be freed while the
+   * dict is alive: a racing thread may still be looking at it. Retired
+   * tables are kept (empty) until the dict is cleared; growth is geometric
+   * so together they stay smaller than the live table.
+   */
+  ConcurrentDictTable* retired;
+  Py_ssize_t migrated; /* buckets of old_table fully migrated */
+  Py_ssize_t next_migrate; /* next old bucket index to sweep */
+  int growable;
+  MUTEX_TYPE grow_mutex;
   PyObject* weakreflist;
 } ConcurrentDictObject;
 
-static int ConcurrentDict_clear(ConcurrentDictObject* self) {
-  if (self->buckets) {
-    for (Py_ssize_t i = 0; i < self->size; i++) {
-      Py_CLEAR(self->buckets[i]);
+/* Average entries per shard before a growable dict triggers a grow. */
+#define CONCURRENT_DICT_MAX_SHARD_LOAD 64
+/* How many extra old buckets each keyed operation migrates. */
+#define CONCURRENT_DICT_MIGRATE_STRIDE 2
+/* Shard count multiplier on grow. */
+#define CONCURRENT_DICT_GROWTH_FACTOR 4
+
+/* Hash a key for shard selection. Exact str keys reuse the hash cached in
+ * the unicode object and exact int keys call their tp_hash slot directly,
+ * skipping the generic PyObject_Hash dispatch; everything else goes the
+ * generic route. The exact-type checks keep subclasses with overridden
+ * __hash__ on the generic path.
+ */
+static inline Py_hash_t ConcurrentDict_key_hash(PyObject* key) {
+  if (PyUnicode_CheckExact(key)) {
+    Py_hash_t hash =
+        _Py_atomic_load_ssize_relaxed(&((PyASCIIObject*)key)->hash);
+    if (hash != -1) {
+      return hash;
+    }
+    return PyObject_Hash(key);
+  }
+  if (PyLong_CheckExact(key)) {
+    return PyLong_Type.tp_hash(key);
+  }
+  return PyObject_Hash(key);
+}
+
+static ConcurrentDictTable* ConcurrentDictTable_alloc(Py_ssize_t size) {
+  ConcurrentDictTable* table = PyMem_Malloc(sizeof(ConcurrentDictTable));
+  if (table == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  table->buckets = (PyObject**)PyMem_Calloc(size, sizeof(PyObject*));
+  if (table->buckets == NULL) {
+    PyMem_Free(table);
+    PyErr_NoMemory();
+    return NULL;
+  }
+  table->size = size;
+  table->next_retired = NULL;
+  for (Py_ssize_t i = 0; i < size; i++) {
+    table->buckets[i] = PyDict_New();
+    if (table->buckets[i] == NULL) {
+      for (Py_ssize_t j = 0; j < i; j++) {
+        Py_DECREF(table->buckets[j]);
+      }
+      PyMem_Free(table->buckets);
+      PyMem_Free(table);
+      return NULL;
     }
-    PyMem_Free(self->buckets);
-    self->buckets = NULL;
-    self->size = 0;
   }
+  return table;
+}
+
+static void ConcurrentDictTable_dealloc(ConcurrentDictTable* table) {
+  if (table == NULL) {
+    return;
+  }
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    Py_CLEAR(table->buckets[i]);
+  }
+  PyMem_Free(table->buckets);
+  PyMem_Free(table);
+}
+
+static inline Py_ssize_t ConcurrentDictTable_index(
+    ConcurrentDictTable* table,
+    Py_hash_t hash) {
+  Py_ssize_t index = hash % table->size;
+  if (index < 0) {
+    index = -index;
+  }
+  return index;
+}
+
+/* Move every entry of old bucket i into the current table. Must be called
+ * with grow_mutex held. Returns -1 on error.
+ */
+static int ConcurrentDict_migrate_bucket(
+    ConcurrentDictObject* self,
+    Py_ssize_t i) {
+  PyObject* bucket = self->old_table->buckets[i];
+  if (PyDict_Size(bucket) == 0) {
+    return 0;
+  }
+  PyObject* key;
+  PyObject* value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(bucket, &pos, &key, &value)) {
+    Py_hash_t hash = ConcurrentDict_key_hash(key);
+    if (hash == -1 && PyErr_Occurred()) {
+      return -1;
+    }
+    Py_ssize_t index = ConcurrentDictTable_index(self->table, hash);
+    if (PyDict_SetItem(self->table->buckets[index], key, value) < 0) {
+      return -1;
+    }
+  }
+  /* The entries are now visible in the current table so the old copies can
+   * go away. A writer racing the grow can re-populate this bucket after the
+   * clear; it notices the table swap once its write completes and retries
+   * through ConcurrentDict_shard, which re-runs this migration for any old
+   * bucket that is not empty before the retry consults the current table.
+   */
+  PyDict_Clear(bucket);
   return 0;
 }
 
-static int ConcurrentDict_setitem(
+/* Unhook a fully drained old_table. Must be called with grow_mutex held.
+ * The table is pushed onto the retired list rather than freed; see the
+ * field comment on ConcurrentDictObject.retired.
+ */
+static void ConcurrentDict_retire_old_table(ConcurrentDictObject* self) {
+  ConcurrentDictTable* old = self->old_table;
+  _Py_atomic_store_ptr((void**)&self->old_table, NULL);
+  old->next_retired = self->retired;
+  self->retired = old;
+}
+
+/* Help an in-progress grow along and return a new reference to the bucket
+ * the given hash lives in within the current table, recording the table it
+ * came from in *table_used. Every keyed operation routes through here so
+ * the rehash cost is spread across callers instead of being paid in one
+ * stop-the-world pass. A grow may republish the table while the caller is
+ * still operating on the returned bucket; the caller must re-check the
+ * table pointer afterwards (ConcurrentDict_table_stale) and retry if it
+ * moved, because the bucket it used may have drained mid-operation.
+ */
+static PyObject* ConcurrentDict_shard(
+    ConcurrentDictObject* self,
+    Py_hash_t hash,
+    ConcurrentDictTable** table_used) {
+  if (_Py_atomic_load_ptr(&self->old_table) != NULL) {
+    MUTEX_LOCK(self->grow_mutex);
+    ConcurrentDictTable* old = self->old_table;
+    if (old != NULL) {
+      /* First make sure the bucket this key hashes to in the old table has
+       * drained, so a plain lookup in the current table is authoritative.
+       */
+      Py_ssize_t index = ConcurrentDictTable_index(old, hash);
+      if (old->buckets[index] != NULL &&
+          PyDict_Size(old->buckets[index]) != 0) {
+        if (ConcurrentDict_migrate_bucket(self, index) < 0) {
+          MUTEX_UNLOCK(self->grow_mutex);
+          return NULL;
+        }
+      }
+      /* Then sweep a few more buckets so the grow finishes even if the key
+       * distribution is skewed.
+       */
+      for (int step = 0; step < CONCURRENT_DICT_MIGRATE_STRIDE &&
+           self->next_migrate < old->size;
+           step++) {
+        if (ConcurrentDict_migrate_bucket(self, self->next_migrate) < 0) {
+          MUTEX_UNLOCK(self->grow_mutex);
+          return NULL;
+        }
+        self->next_migrate++;
+        self->migrated++;
+      }
+      if (self->migrated >= old->size) {
+        ConcurrentDict_retire_old_table(self);
+      }
+    }
+    MUTEX_UNLOCK(self->grow_mutex);
+  }
+  ConcurrentDictTable* table = _Py_atomic_load_ptr(&self->table);
+  *table_used = table;
+  return Py_NewRef(table->buckets[ConcurrentDictTable_index(table, hash)]);
+}
+
+/* True if a grow republished the table after a keyed operation picked its
+ * bucket, in which case the bucket may have drained under the operation and
+ * the operation must be retried against the current table.
+ */
+static inline int ConcurrentDict_table_stale(
+    ConcurrentDictObject* self,
+    ConcurrentDictTable* table_used) {
+  return _Py_atomic_load_ptr(&self->table) != table_used;
+}
+
+/* Complete any in-progress grow. Used by whole-dict operations (iteration,
+ * keys, clear, ...) which are simpler and no slower against a single table.
+ */
+static int ConcurrentDict_finish_grow(ConcurrentDictObject* self) {
+  if (_Py_atomic_load_ptr(&self->old_table) == NULL) {
+    return 0;
+  }
+  MUTEX_LOCK(self->grow_mutex);
+  ConcurrentDictTable* old = self->old_table;
+  if (old != NULL) {
+    while (self->next_migrate < old->size) {
+      if (ConcurrentDict_migrate_bucket(self, self->next_migrate) < 0) {
+        MUTEX_UNLOCK(self->grow_mutex);
+        return -1;
+      }
+      self->next_migrate++;
+      self->migrated++;
+    }
+    ConcurrentDict_retire_old_table(self);
+  }
+  MUTEX_UNLOCK(self->grow_mutex);
+  return 0;
+}
+
+/* Kick off a grow if the shard this key landed in has gone past the load
+ * limit. Publishing the new table is just a pointer swap; draining the old
+ * table happens incrementally in ConcurrentDict_shard.
+ */
+static int ConcurrentDict_maybe_grow(
     ConcurrentDictObject* self,
+    PyObject* bucket) {
+  if (!self->growable || _Py_atomic_load_ptr(&self->old_table) != NULL ||
+      PyDict_Size(bucket) <= CONCURRENT_DICT_MAX_SHARD_LOAD) {
+    return 0;
+  }
+  MUTEX_LOCK(self->grow_mutex);
+  if (self->old_table != NULL) {
+    /* Another thread beat us to it. */
+    MUTEX_UNLOCK(self->grow_mutex);
+    return 0;
+  }
+  ConcurrentDictTable* next_table = ConcurrentDictTable_alloc(
+      self->table->size * CONCURRENT_DICT_GROWTH_FACTOR + 1);
+  if (next_table == NULL) {
+    MUTEX_UNLOCK(self->grow_mutex);
+    return -1;
+  }
+  self->migrated = 0;
+  self->next_migrate = 0;
+  _Py_atomic_store_ptr((void**)&self->old_table, self->table);
+  _Py_atomic_store_ptr((void**)&self->table, next_table);
+  MUTEX_UNLOCK(self->grow_mutex);
+  return 0;
+}
+
+static int ConcurrentDict_clear(ConcurrentDictObject* self) {
+  if (self->table != NULL) {
+    ConcurrentDictTable_dealloc(self->table);
+    self->table = NULL;
+  }
+  if (self->old_table != NULL) {
+    ConcurrentDictTable_dealloc(self->old_table);
+    self->old_table = NULL;
+  }
+  while (self->retired != NULL) {
+    ConcurrentDictTable* next = self->retired->next_retired;
+    ConcurrentDictTable_dealloc(self->retired);
+    self->retired = next;
+  }
+  return 0;
+}
+
+/* Set (or with value == NULL delete) key in its bucket. If a grow
+ * republished the table mid-operation the write may have landed in (or a
+ * delete may have missed) a bucket that had already drained, so retry
+ * against the current table; ConcurrentDict_shard migrates this key's old
+ * bucket first, which also carries over any write left behind by an earlier
+ * attempt.
+ */
+static int ConcurrentDict_store(
+    ConcurrentDictObject* self,
+    Py_hash_t hash,
     PyObject* key,
     PyObject* value) {
-  Py_hash_t hash = PyObject_Hash(key);
-  if (hash == -1 && PyErr_Occurred()) {
-    return -1;
+  int deleted = 0;
+  for (;;) {
+    ConcurrentDictTable* used;
+    PyObject* bucket = ConcurrentDict_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return -1;
+    }
+    int rc = value != NULL ? PyDict_SetItem(bucket, key, value)
+                           : PyDict_DelItem(bucket, key);
+    if (!ConcurrentDict_table_stale(self, used)) {
+      if (rc < 0 && deleted && PyErr_ExceptionMatches(PyExc_KeyError)) {
+        /* An earlier attempt removed the entry just before its bucket
+         * drained, so the delete did happen. */
+        PyErr_Clear();
+        rc = 0;
+      }
+      if (rc == 0 && value != NULL) {
+        rc = ConcurrentDict_maybe_grow(self, bucket);
+      }
+      Py_DECREF(bucket);
+      return rc;
+    }
+    if (rc < 0) {
+      PyErr_Clear();
+    } else if (value == NULL) {
+      deleted = 1;
+    } else if (_Py_atomic_load_ptr(&self->old_table) != used) {
+      /* The table this write landed in has fully drained and retired, so
+       * no migration will ever move the entry out again; scrub it rather
+       * than leave a stray strong reference behind. Keyed operations never
+       * trust a retired bucket, so the removal is not observable.
+       */
+      if (PyDict_DelItem(bucket, key) < 0) {
+        PyErr_Clear();
+      }
+    }
+    Py_DECREF(bucket);
   }
+}
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
+/* Look up key, returning 1 with *value set to a new reference on a hit, 0
+ * on a miss and -1 on error. A hit is always good, but a miss against a
+ * bucket a concurrent grow may have drained says nothing about the current
+ * table, so a stale miss retries.
+ */
+static int ConcurrentDict_lookup(
+    ConcurrentDictObject* self,
+    Py_hash_t hash,
+    PyObject* key,
+    PyObject** value) {
+  for (;;) {
+    ConcurrentDictTable* used;
+    PyObject* bucket = ConcurrentDict_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return -1;
+    }
+    int rc = PyDict_GetItemRef(bucket, key, value);
+    Py_DECREF(bucket);
+    if (rc != 0 || !ConcurrentDict_table_stale(self, used)) {
+      return rc;
+    }
   }
+}
 
-  return value != NULL ? PyDict_SetItem(self->buckets[index], key, value)
-                       : PyDict_DelItem(self->buckets[index], key);
+/* Remove key from bucket, returning 1 with *value set to a new reference,
+ * 0 when missing and -1 on error. Folds the pre-free-threading lookup then
+ * delete sequence into the same contract as PyDict_Pop.
+ */
+static int ConcurrentDict_bucket_pop(
+    PyObject* bucket,
+    PyObject* key,
+    PyObject** value) {
+#ifdef Py_GIL_DISABLED
+  return PyDict_Pop(bucket, key, value);
+#else
+  int rc = PyDict_GetItemRef(bucket, key, value);
+  if (rc <= 0) {
+    return rc;
+  }
+  if (PyDict_DelItem(bucket, key) < 0) {
+    /* Another thread removed the key between the lookup and the delete;
+     * treat that as missing. */
+    Py_CLEAR(*value);
+    if (!PyErr_ExceptionMatches(PyExc_KeyError)) {
+      return -1;
+    }
+    PyErr_Clear();
+    return 0;
+  }
+  return 1;
+#endif
+}
+
+/* Remove and return key's value with the same 1/0/-1 contract as
+ * ConcurrentDict_bucket_pop, retrying when a grow overlaps. An attempt
+ * which removed the entry just before its bucket drained keeps the value
+ * it popped, so a subsequent miss still reports the removal.
+ */
+static int ConcurrentDict_pop_key(
+    ConcurrentDictObject* self,
+    Py_hash_t hash,
+    PyObject* key,
+    PyObject** value) {
+  PyObject* popped = NULL;
+  for (;;) {
+    ConcurrentDictTable* used;
+    PyObject* bucket = ConcurrentDict_shard(self, hash, &used);
+    if (bucket == NULL) {
+      Py_XDECREF(popped);
+      return -1;
+    }
+    int rc = ConcurrentDict_bucket_pop(bucket, key, value);
+    Py_DECREF(bucket);
+    if (!ConcurrentDict_table_stale(self, used)) {
+      if (rc == 0 && popped != NULL) {
+        *value = popped;
+        return 1;
+      }
+      Py_XDECREF(popped);
+      return rc;
+    }
+    if (rc < 0) {
+      PyErr_Clear();
+    } else if (rc == 1) {
+      Py_XSETREF(popped, *value);
+      *value = NULL;
+    }
+  }
+}
+
+static int ConcurrentDict_setitem(
+    ConcurrentDictObject* self,
+    PyObject* key,
+    PyObject* value) {
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
+  if (hash == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  return ConcurrentDict_store(self, hash, key, value);
 }
 
 static void ConcurrentDict_dealloc(ConcurrentDictObject* self) {
   PyObject_GC_UnTrack(self);
   ConcurrentDict_clear(self);
+  if (MUTEX_DESTROY(self->grow_mutex)) {
+    Py_FatalError("Failed to destroy ConcurrentDict mutex.");
+  }
   PyObject_ClearWeakRefs((PyObject*)self);
   PyObject_GC_Del(self);
 }
@@ -51,10 +458,17 @@ static PyObject*
 ConcurrentDict_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
   Py_ssize_t initial_capacity = 0;
   PyObject* dictionary = NULL;
-  static char* kwlist[] = {"initial_capacity", "dictionary", NULL};
+  int growable = 0;
+  static char* kwlist[] = {"initial_capacity", "dictionary", "growable", NULL};
 
   if (!PyArg_ParseTupleAndKeywords(
-          args, kwds, "|nO", kwlist, &initial_capacity, &dictionary)) {
+          args,
+          kwds,
+          "|nOp",
+          kwlist,
+          &initial_capacity,
+          &dictionary,
+          &growable)) {
     return NULL;
   }
 
@@ -78,21 +492,20 @@ ConcurrentDict_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
 
   ConcurrentDictObject* self = (ConcurrentDictObject*)type->tp_alloc(type, 0);
   if (self != NULL) {
-    self->buckets =
-        (PyObject**)PyMem_Calloc(initial_capacity, sizeof(PyObject*));
-    if (!self->buckets) {
-      PyErr_NoMemory();
+    if (MUTEX_INIT(self->grow_mutex)) {
+      PyErr_SetString(PyExc_RuntimeError, "Failed to initialize locks.");
       Py_DECREF(self);
       return NULL;
     }
-
-    self->size = initial_capacity;
-    for (Py_ssize_t i = 0; i < initial_capacity; i++) {
-      self->buckets[i] = PyDict_New();
-      if (!self->buckets[i]) {
-        Py_DECREF(self);
-        return NULL;
-      }
+    self->old_table = NULL;
+    self->retired = NULL;
+    self->migrated = 0;
+    self->next_migrate = 0;
+    self->growable = growable;
+    self->table = ConcurrentDictTable_alloc(initial_capacity);
+    if (self->table == NULL) {
+      Py_DECREF(self);
+      return NULL;
     }
 
     if (dictionary != NULL) {
@@ -113,18 +526,13 @@ ConcurrentDict_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
 static PyObject* ConcurrentDict_getitem(
     ConcurrentDictObject* self,
     PyObject* key) {
-  Py_hash_t hash = PyObject_Hash(key);
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
   if (hash == -1 && PyErr_Occurred()) {
     return NULL;
   }
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
-  }
-
   PyObject* value = NULL;
-  int result = PyDict_GetItemRef(self->buckets[index], key, &value);
+  int result = ConcurrentDict_lookup(self, hash, key, &value);
   if (result < 0) {
     return NULL;
   } else if (result == 0) {
@@ -136,29 +544,31 @@ static PyObject* ConcurrentDict_getitem(
 }
 
 static int ConcurrentDict_contains(ConcurrentDictObject* self, PyObject* key) {
-  Py_hash_t hash = PyObject_Hash(key);
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
   if (hash == -1 && PyErr_Occurred()) {
     return -1;
   }
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
-  }
-
-  return PyDict_Contains(self->buckets[index], key);
+  PyObject* value = NULL;
+  int result = ConcurrentDict_lookup(self, hash, key, &value);
+  Py_XDECREF(value);
+  return result;
 }
 
 static PyObject* ConcurrentDict_as_dict(
     ConcurrentDictObject* self,
     PyObject* Py_UNUSED(args)) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
   PyObject* dict = PyDict_New();
   if (!dict) {
     return NULL;
   }
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      if (PyDict_Update(dict, self->buckets[i]) != 0) {
+  ConcurrentDictTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      if (PyDict_Update(dict, table->buckets[i]) != 0) {
         Py_DECREF(dict);
         return NULL;
       }
@@ -171,9 +581,13 @@ static PyObject* ConcurrentDict_as_dict(
 static PyObject* ConcurrentDict_clearmethod(
     ConcurrentDictObject* self,
     PyObject* Py_UNUSED(args)) {
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      PyDict_Clear(self->buckets[i]);
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
+  ConcurrentDictTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PyDict_Clear(table->buckets[i]);
     }
   }
   Py_RETURN_NONE;
@@ -190,18 +604,13 @@ static PyObject* ConcurrentDict_get(
     return NULL;
   }
 
-  Py_hash_t hash = PyObject_Hash(key);
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
   if (hash == -1 && PyErr_Occurred()) {
     return NULL;
   }
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
-  }
-
   PyObject* value = NULL;
-  int result = PyDict_GetItemRef(self->buckets[index], key, &value);
+  int result = ConcurrentDict_lookup(self, hash, key, &value);
   if (result < 0) {
     return NULL;
   } else if (result == 0) {
@@ -224,29 +633,42 @@ static PyObject* ConcurrentDict_setdefault(
     return NULL;
   }
 
-  Py_hash_t hash = PyObject_Hash(key);
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
   if (hash == -1 && PyErr_Occurred()) {
     return NULL;
   }
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
-  }
+  for (;;) {
+    ConcurrentDictTable* used;
+    PyObject* bucket = ConcurrentDict_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return NULL;
+    }
 #ifdef Py_GIL_DISABLED
-  PyObject* value = NULL;
-  if (PyDict_SetDefaultRef(self->buckets[index], key, default_value, &value) <
-      0) {
-    return NULL;
-  }
-  return value;
+    PyObject* value = NULL;
+    int rc = PyDict_SetDefaultRef(bucket, key, default_value, &value);
 #else
-  PyObject* value = PyDict_SetDefault(self->buckets[index], key, default_value);
-  if (value == NULL) {
-    return NULL;
-  }
-  return Py_NewRef(value);
+    PyObject* value = Py_XNewRef(PyDict_SetDefault(bucket, key, default_value));
+    int rc = value != NULL ? 0 : -1;
 #endif
+    if (!ConcurrentDict_table_stale(self, used)) {
+      Py_DECREF(bucket);
+      return value;
+    }
+    /* A grow overlapped; the insert (if any) may sit in a drained bucket.
+     * Scrub one stranded in a retired table, as in ConcurrentDict_store,
+     * then retry against the current table.
+     */
+    if (rc < 0) {
+      PyErr_Clear();
+    } else if (_Py_atomic_load_ptr(&self->old_table) != used) {
+      if (PyDict_DelItem(bucket, key) < 0) {
+        PyErr_Clear();
+      }
+    }
+    Py_XDECREF(value);
+    Py_DECREF(bucket);
+  }
 }
 
 /* Remove and return the value for key.
@@ -261,32 +683,13 @@ static PyObject* ConcurrentDict_pop(
     return NULL;
   }
 
-  Py_hash_t hash = PyObject_Hash(key);
+  Py_hash_t hash = ConcurrentDict_key_hash(key);
   if (hash == -1 && PyErr_Occurred()) {
     return NULL;
   }
 
-  Py_ssize_t index = hash % self->size;
-  if (index < 0) {
-    index = -index;
-  }
-
-#ifdef Py_GIL_DISABLED
-  PyObject* value = NULL;
-  int result = PyDict_Pop(self->buckets[index], key, &value);
-  if (result < 0) {
-    return NULL;
-  } else if (result == 0) {
-    if (default_value != NULL) {
-      return Py_NewRef(default_value);
-    }
-    PyErr_SetObject(PyExc_KeyError, key);
-    return NULL;
-  }
-  return value;
-#else
   PyObject* value = NULL;
-  int result = PyDict_GetItemRef(self->buckets[index], key, &value);
+  int result = ConcurrentDict_pop_key(self, hash, key, &value);
   if (result < 0) {
     return NULL;
   } else if (result == 0) {
@@ -296,12 +699,7 @@ static PyObject* ConcurrentDict_pop(
     PyErr_SetObject(PyExc_KeyError, key);
     return NULL;
   }
-  if (PyDict_DelItem(self->buckets[index], key) < 0) {
-    Py_DECREF(value);
-    return NULL;
-  }
   return value;
-#endif
 }
 
 /* Update from a mapping that supports keys() and __getitem__. */
@@ -367,6 +765,164 @@ static int ConcurrentDict_update_from_pairs(
   return 0;
 }
 
+/* Insert a batch of (key, value) pairs in one C-level pass.
+ *
+ * Because each shard is a PyDict, applying a batch is a single loop of
+ * hash/shard/PyDict_SetItem with no Python call dispatch between items;
+ * grouping by shard first would add a pass without saving any locking.
+ * Not thread consistent across the batch — other threads may observe a
+ * partially applied batch.
+ */
+static PyObject* ConcurrentDict_update_batch(
+    ConcurrentDictObject* self,
+    PyObject* pairs) {
+  PyObject* fast =
+      PySequence_Fast(pairs, "update_batch requires an iterable of pairs");
+  if (fast == NULL) {
+    return NULL;
+  }
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+  PyObject** items = PySequence_Fast_ITEMS(fast);
+
+  /* Pre-register the values in bulk before any of them are published; one
+   * batch call per group of pairs rather than one registration per object.
+   * Pairs which are not plain 2-tuples are picked up by the insert loop.
+   */
+  PyObject* batch[64];
+  Py_ssize_t batched = 0;
+  for (Py_ssize_t i = 0; i < n; i++) {
+    if (PyTuple_CheckExact(items[i]) && PyTuple_GET_SIZE(items[i]) == 2) {
+      batch[batched++] = PyTuple_GET_ITEM(items[i], 1);
+      if (batched == 64) {
+        ConcurrentRegisterReferenceBatch(batch, batched);
+        batched = 0;
+      }
+    }
+  }
+  ConcurrentRegisterReferenceBatch(batch, batched);
+
+  for (Py_ssize_t i = 0; i < n; i++) {
+    PyObject* key = NULL;
+    PyObject* value = NULL;
+    if (!PyArg_ParseTuple(items[i], "OO", &key, &value)) {
+      Py_DECREF(fast);
+      return NULL;
+    }
+    if (!(PyTuple_CheckExact(items[i]) && PyTuple_GET_SIZE(items[i]) == 2)) {
+      ConcurrentRegisterReference(value);
+    }
+    if (ConcurrentDict_setitem(self, key, value) < 0) {
+      Py_DECREF(fast);
+      return NULL;
+    }
+  }
+  Py_DECREF(fast);
+  Py_RETURN_NONE;
+}
+
+/* Look up a batch of keys in one C-level pass, returning a list of values
+ * in key order. Missing keys yield the default (None if not given).
+ * Not thread consistent across the batch.
+ */
+static PyObject* ConcurrentDict_get_many(
+    ConcurrentDictObject* self,
+    PyObject* args) {
+  PyObject* keys;
+  PyObject* default_value = Py_None;
+
+  if (!PyArg_ParseTuple(args, "O|O", &keys, &default_value)) {
+    return NULL;
+  }
+
+  PyObject* fast = PySequence_Fast(keys, "get_many requires an iterable");
+  if (fast == NULL) {
+    return NULL;
+  }
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+  PyObject* result = PyList_New(n);
+  if (result == NULL) {
+    Py_DECREF(fast);
+    return NULL;
+  }
+  PyObject** items = PySequence_Fast_ITEMS(fast);
+  for (Py_ssize_t i = 0; i < n; i++) {
+    PyObject* key = items[i];
+    Py_hash_t hash = ConcurrentDict_key_hash(key);
+    if (hash == -1 && PyErr_Occurred()) {
+      goto fail;
+    }
+    PyObject* value = NULL;
+    int rc = ConcurrentDict_lookup(self, hash, key, &value);
+    if (rc < 0) {
+      goto fail;
+    } else if (rc == 0) {
+      value = Py_NewRef(default_value);
+    }
+    PyList_SET_ITEM(result, i, value);
+  }
+  Py_DECREF(fast);
+  return result;
+
+fail:
+  Py_DECREF(fast);
+  Py_DECREF(result);
+  return NULL;
+}
+
+/* Remove a batch of keys in one C-level pass, returning a list of the
+ * removed values in key order. Missing keys yield the default, or raise
+ * KeyError if no default is given. Not thread consistent across the batch;
+ * on error, keys processed so far stay removed.
+ */
+static PyObject* ConcurrentDict_pop_many(
+    ConcurrentDictObject* self,
+    PyObject* args) {
+  PyObject* keys;
+  PyObject* default_value = NULL;
+
+  if (!PyArg_ParseTuple(args, "O|O", &keys, &default_value)) {
+    return NULL;
+  }
+
+  PyObject* fast = PySequence_Fast(keys, "pop_many requires an iterable");
+  if (fast == NULL) {
+    return NULL;
+  }
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+  PyObject* result = PyList_New(n);
+  if (result == NULL) {
+    Py_DECREF(fast);
+    return NULL;
+  }
+  PyObject** items = PySequence_Fast_ITEMS(fast);
+  for (Py_ssize_t i = 0; i < n; i++) {
+    PyObject* key = items[i];
+    Py_hash_t hash = ConcurrentDict_key_hash(key);
+    if (hash == -1 && PyErr_Occurred()) {
+      goto fail;
+    }
+    PyObject* value = NULL;
+    int rc = ConcurrentDict_pop_key(self, hash, key, &value);
+    if (rc < 0) {
+      goto fail;
+    } else if (rc == 0) {
+      if (default_value == NULL) {
+        PyErr_SetObject(PyExc_KeyError, key);
+        goto fail;
+      }
+      value = Py_NewRef(default_value);
+    }
+    PyList_SET_ITEM(result, i, value);
+  }
+  Py_DECREF(fast);
+  return result;
+
+fail:
+  Py_DECREF(fast);
+  Py_DECREF(result);
+  return NULL;
+}
+
 /* Update this ConcurrentDict from a mapping or iterable of key-value pairs.
  *
  *   cd = ConcurrentDict()
@@ -422,13 +978,17 @@ static PyObject* ConcurrentDict_update(
 static PyObject* ConcurrentDict_keys(
     ConcurrentDictObject* self,
     PyObject* Py_UNUSED(args)) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
   PyObject* list = PyList_New(0);
   if (!list) {
     return NULL;
   }
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      PyObject* bucket_keys = PyDict_Keys(self->buckets[i]);
+  ConcurrentDictTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PyObject* bucket_keys = PyDict_Keys(table->buckets[i]);
       if (!bucket_keys) {
         Py_DECREF(list);
         return NULL;
@@ -451,13 +1011,17 @@ static PyObject* ConcurrentDict_keys(
 static PyObject* ConcurrentDict_values(
     ConcurrentDictObject* self,
     PyObject* Py_UNUSED(args)) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
   PyObject* list = PyList_New(0);
   if (!list) {
     return NULL;
   }
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      PyObject* bucket_values = PyDict_Values(self->buckets[i]);
+  ConcurrentDictTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PyObject* bucket_values = PyDict_Values(table->buckets[i]);
       if (!bucket_values) {
         Py_DECREF(list);
         return NULL;
@@ -480,13 +1044,17 @@ static PyObject* ConcurrentDict_values(
 static PyObject* ConcurrentDict_items(
     ConcurrentDictObject* self,
     PyObject* Py_UNUSED(args)) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
   PyObject* list = PyList_New(0);
   if (!list) {
     return NULL;
   }
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      PyObject* bucket_items = PyDict_Items(self->buckets[i]);
+  ConcurrentDictTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PyObject* bucket_items = PyDict_Items(table->buckets[i]);
       if (!bucket_items) {
         Py_DECREF(list);
         return NULL;
@@ -547,11 +1115,12 @@ static PyObject* ConcurrentDictIterator_next(
   if (dict == NULL) {
     return NULL;
   }
+  ConcurrentDictTable* table = _Py_atomic_load_ptr(&dict->table);
 
   PyObject* key;
   PyObject* value;
-  while (self->bucket_index < dict->size) {
-    PyObject* bucket = dict->buckets[self->bucket_index];
+  while (self->bucket_index < table->size) {
+    PyObject* bucket = table->buckets[self->bucket_index];
     if (bucket && PyDict_Next(bucket, &self->pos, &key, &value)) {
       return Py_NewRef(key);
     }
@@ -581,6 +1150,9 @@ PyTypeObject ConcurrentDictIteratorType = {
 };
 
 static PyObject* ConcurrentDict_iter(ConcurrentDictObject* self) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
   ConcurrentDictIteratorObject* iterator = PyObject_GC_New(
       ConcurrentDictIteratorObject, &ConcurrentDictIteratorType);
 
@@ -597,6 +1169,141 @@ static PyObject* ConcurrentDict_iter(ConcurrentDictObject* self) {
   return (PyObject*)iterator;
 }
 
+/* ---- Snapshot iterator ---- */
+
+/* Iterates shard-by-shard over a private copy of one shard at a time, so
+ * the extra memory is bounded by the largest shard rather than the whole
+ * dict (unlike as_dict). Each shard copy is internally consistent; the view
+ * across shards is only as consistent as the usual "not thread consistent"
+ * contract.
+ */
+typedef struct {
+  PyObject_HEAD ConcurrentDictObject* dict;
+  PyObject* snapshot; /* private copy of the shard being walked */
+  Py_ssize_t bucket_index; /* next shard to snapshot */
+  Py_ssize_t pos; /* position within snapshot (for PyDict_Next) */
+  int yield_items; /* 1 -> (key, value) tuples, 0 -> keys */
+  PyObject* weakreflist;
+} ConcurrentDictSnapshotIteratorObject;
+
+static int ConcurrentDictSnapshotIterator_clear(
+    ConcurrentDictSnapshotIteratorObject* self) {
+  Py_CLEAR(self->dict);
+  Py_CLEAR(self->snapshot);
+  return 0;
+}
+
+static int ConcurrentDictSnapshotIterator_traverse(
+    ConcurrentDictSnapshotIteratorObject* self,
+    visitproc visit,
+    void* arg) {
+  Py_VISIT(self->dict);
+  Py_VISIT(self->snapshot);
+  return 0;
+}
+
+static void ConcurrentDictSnapshotIterator_dealloc(
+    ConcurrentDictSnapshotIteratorObject* self) {
+  PyObject_GC_UnTrack(self);
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  (void)ConcurrentDictSnapshotIterator_clear(self);
+  PyObject_GC_Del(self);
+}
+
+static PyObject* ConcurrentDictSnapshotIterator_next(
+    ConcurrentDictSnapshotIteratorObject* self) {
+  ConcurrentDictObject* dict = self->dict;
+  if (dict == NULL) {
+    return NULL;
+  }
+
+  PyObject* key;
+  PyObject* value;
+  for (;;) {
+    if (self->snapshot != NULL &&
+        PyDict_Next(self->snapshot, &self->pos, &key, &value)) {
+      if (self->yield_items) {
+        return PyTuple_Pack(2, key, value);
+      }
+      return Py_NewRef(key);
+    }
+    Py_CLEAR(self->snapshot);
+    ConcurrentDictTable* table = _Py_atomic_load_ptr(&dict->table);
+    if (self->bucket_index >= table->size) {
+      return NULL;
+    }
+    PyObject* bucket = table->buckets[self->bucket_index];
+    self->bucket_index++;
+    self->pos = 0;
+    if (bucket == NULL) {
+      continue;
+    }
+    self->snapshot = PyDict_Copy(bucket);
+    if (self->snapshot == NULL) {
+      return NULL;
+    }
+  }
+}
+
+PyTypeObject ConcurrentDictSnapshotIteratorType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name =
+        "_concurrency.ConcurrentDictSnapshotIterator",
+    .tp_doc = "ConcurrentDictSnapshotIterator",
+    .tp_basicsize = sizeof(ConcurrentDictSnapshotIteratorObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_weaklistoffset =
+        offsetof(ConcurrentDictSnapshotIteratorObject, weakreflist),
+
+    .tp_clear = (inquiry)ConcurrentDictSnapshotIterator_clear,
+    .tp_traverse = (traverseproc)ConcurrentDictSnapshotIterator_traverse,
+    .tp_dealloc = (destructor)ConcurrentDictSnapshotIterator_dealloc,
+
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)ConcurrentDictSnapshotIterator_next,
+};
+
+static PyObject* ConcurrentDict_snapshot_iter(
+    ConcurrentDictObject* self,
+    int yield_items) {
+  if (ConcurrentDict_finish_grow(self) < 0) {
+    return NULL;
+  }
+  ConcurrentDictSnapshotIteratorObject* iterator = PyObject_GC_New(
+      ConcurrentDictSnapshotIteratorObject,
+      &ConcurrentDictSnapshotIteratorType);
+
+  if (iterator == NULL) {
+    return NULL;
+  }
+
+  iterator->dict = (ConcurrentDictObject*)Py_NewRef(self);
+  iterator->snapshot = NULL;
+  iterator->bucket_index = 0;
+  iterator->pos = 0;
+  iterator->yield_items = yield_items;
+  iterator->weakreflist = NULL;
+
+  PyObject_GC_Track(iterator);
+  return (PyObject*)iterator;
+}
+
+/* Iterate keys against per-shard snapshots. O(largest shard) extra memory. */
+static PyObject* ConcurrentDict_iter_snapshot(
+    ConcurrentDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+  return ConcurrentDict_snapshot_iter(self, 0);
+}
+
+/* Iterate (key, value) pairs against per-shard snapshots. */
+static PyObject* ConcurrentDict_items_snapshot(
+    ConcurrentDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+  return ConcurrentDict_snapshot_iter(self, 1);
+}
+
 /* ---- GC / infrastructure ---- */
 
 /* Compare two ConcurrentDicts for equality.
@@ -683,18 +1390,46 @@ static int ConcurrentDict_traverse(
     ConcurrentDictObject* self,
     visitproc visit,
     void* arg) {
+  /* May not call back into Python here so both tables are walked directly
+   * rather than finishing any in-progress grow. */
   Py_ssize_t i;
-  for (i = 0; i < self->size; i++) {
-    Py_VISIT(self->buckets[i]);
+  if (self->table != NULL) {
+    for (i = 0; i < self->table->size; i++) {
+      Py_VISIT(self->table->buckets[i]);
+    }
+  }
+  if (self->old_table != NULL) {
+    for (i = 0; i < self->old_table->size; i++) {
+      Py_VISIT(self->old_table->buckets[i]);
+    }
+  }
+  /* Retired buckets are normally empty, but a writer racing a grow can
+   * repopulate one briefly before its retry scrubs it. */
+  for (ConcurrentDictTable* t = self->retired; t != NULL; t = t->next_retired) {
+    for (i = 0; i < t->size; i++) {
+      Py_VISIT(t->buckets[i]);
+    }
   }
   return 0;
 }
 
 static Py_ssize_t ConcurrentDict_len(ConcurrentDictObject* self) {
   Py_ssize_t total = 0;
-  for (Py_ssize_t i = 0; i < self->size; i++) {
-    if (self->buckets[i]) {
-      total += PyDict_Size(self->buckets[i]);
+  ConcurrentDictTable* table = _Py_atomic_load_ptr(&self->table);
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      total += PyDict_Size(table->buckets[i]);
+    }
+  }
+  ConcurrentDictTable* old_table = _Py_atomic_load_ptr(&self->old_table);
+  if (old_table != NULL) {
+    /* Entries drain out of old buckets as they migrate so they are only
+     * counted once. The table stays allocated after it drains (see the
+     * retired list) so this unlocked walk never touches freed memory. */
+    for (Py_ssize_t i = 0; i < old_table->size; i++) {
+      if (old_table->buckets[i]) {
+        total += PyDict_Size(old_table->buckets[i]);
+      }
     }
   }
   return total;
@@ -736,6 +1471,31 @@ static PyMethodDef ConcurrentDict_methods[] = {
      METH_VARARGS,
      PyDoc_STR(
          "D.pop(key[, default]) -> value. Remove key and return value. If key is not found, return default or raise KeyError.")},
+    {"iter_snapshot",
+     (PyCFunction)ConcurrentDict_iter_snapshot,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Iterate keys against per-shard snapshots. Extra memory is bounded by the largest shard rather than the whole dict.")},
+    {"items_snapshot",
+     (PyCFunction)ConcurrentDict_items_snapshot,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Iterate (key, value) pairs against per-shard snapshots. Extra memory is bounded by the largest shard rather than the whole dict.")},
+    {"update_batch",
+     (PyCFunction)ConcurrentDict_update_batch,
+     METH_O,
+     PyDoc_STR(
+         "D.update_batch(pairs) -> None. Insert an iterable of (key, value) pairs in one C-level pass. Not thread consistent across the batch.")},
+    {"get_many",
+     (PyCFunction)ConcurrentDict_get_many,
+     METH_VARARGS,
+     PyDoc_STR(
+         "D.get_many(keys[, default]) -> list. Return values for keys in order; missing keys yield default (None if not given). Not thread consistent across the batch.")},
+    {"pop_many",
+     (PyCFunction)ConcurrentDict_pop_many,
+     METH_VARARGS,
+     PyDoc_STR(
+         "D.pop_many(keys[, default]) -> list. Remove keys and return their values in order; missing keys yield default or raise KeyError. Not thread consistent across the batch.")},
     {"update",
      (PyCFunction)ConcurrentDict_update,
      METH_VARARGS | METH_KEYWORDS,
@@ -774,3 +1534,22 @@ PyTypeObject ConcurrentDictType = {
     .tp_repr = (reprfunc)ConcurrentDict_repr,
     .tp_iter = (getiterfunc)ConcurrentDict_iter,
 };
+
+/* C API entry points exported through the ft_utils capsule; see the
+   FTUtils_CAPI notes in ft_utils.h for the calling conventions. */
+
+PyObject* ConcurrentDict_GetItem(PyObject* dict, PyObject* key) {
+  if (!PyObject_TypeCheck(dict, &ConcurrentDictType)) {
+    PyErr_SetString(PyExc_TypeError, "expected a ConcurrentDict");
+    return NULL;
+  }
+  return ConcurrentDict_getitem((ConcurrentDictObject*)dict, key);
+}
+
+int ConcurrentDict_SetItem(PyObject* dict, PyObject* key, PyObject* value) {
+  if (!PyObject_TypeCheck(dict, &ConcurrentDictType)) {
+    PyErr_SetString(PyExc_TypeError, "expected a ConcurrentDict");
+    return -1;
+  }
+  return ConcurrentDict_setitem((ConcurrentDictObject*)dict, key, value);
+}
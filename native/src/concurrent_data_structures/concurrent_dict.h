@@ -7,5 +7,10 @@
 
 extern PyTypeObject ConcurrentDictType;
 extern PyTypeObject ConcurrentDictIteratorType;
+extern PyTypeObject ConcurrentDictSnapshotIteratorType;
+
+/* C API entry points exported through the ft_utils capsule. */
+PyObject* ConcurrentDict_GetItem(PyObject* dict, PyObject* key);
+int ConcurrentDict_SetItem(PyObject* dict, PyObject* key, PyObject* value);
 
 #endif /* CONCURRENT_DICT_H */
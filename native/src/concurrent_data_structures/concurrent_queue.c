@@ -0,0 +1,332 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "concurrent_queue.h"
+
+/* A FIFO queue whose blocking pop parks on a condition variable instead of
+ * the sleep-quantum polling the pure Python ConcurrentQueue falls back to,
+ * so waiters wake as soon as an item is pushed rather than up to a sleep
+ * period later.
+ *
+ * The layout is the classic two-lock queue: a dummy head node, a tail lock
+ * serializing pushers and a head lock serializing poppers, so pushes and
+ * pops run concurrently with each other. Pushers only touch the head lock
+ * when a popper is actually parked.
+ */
+
+typedef struct ConcurrentQueueNode {
+  PyObject* value;
+  struct ConcurrentQueueNode* next;
+} ConcurrentQueueNode;
+
+#define CONCURRENT_QUEUE_SHUTDOWN 1
+#define CONCURRENT_QUEUE_SHUT_NOW 2
+
+typedef struct {
+  PyObject_HEAD ConcurrentQueueNode* head; /* dummy; head->next is front */
+  ConcurrentQueueNode* tail;
+  MUTEX_TYPE head_mutex; /* serializes poppers */
+  MUTEX_TYPE tail_mutex; /* serializes pushers */
+  COND_TYPE not_empty; /* paired with head_mutex */
+  int64_t size;
+  int64_t waiters; /* poppers parked or about to park */
+  int32_t flags;
+  PyObject* weakreflist;
+} ConcurrentQueueObject;
+
+/* Outcome of the detached wait loop in pop, handled once the thread state
+ * is reattached and exceptions may be raised. */
+enum ConcurrentQueuePopStatus {
+  CONCURRENT_QUEUE_POP_OK,
+  CONCURRENT_QUEUE_POP_TIMEOUT,
+  CONCURRENT_QUEUE_POP_SHUTDOWN,
+};
+
+static PyObject* ConcurrentQueue_shutdown_error(void) {
+  static PyObject* exc = NULL;
+  if (exc == NULL) {
+    PyObject* module = PyImport_ImportModule("ft_utils.concurrency");
+    if (module == NULL) {
+      return NULL;
+    }
+    exc = PyObject_GetAttrString(module, "ShutDown");
+    Py_DECREF(module);
+  }
+  return exc;
+}
+
+static PyObject* ConcurrentQueue_empty_error(void) {
+  static PyObject* exc = NULL;
+  if (exc == NULL) {
+    PyObject* module = PyImport_ImportModule("queue");
+    if (module == NULL) {
+      return NULL;
+    }
+    exc = PyObject_GetAttrString(module, "Empty");
+    Py_DECREF(module);
+  }
+  return exc;
+}
+
+static PyObject*
+ConcurrentQueue_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  ConcurrentQueueObject* self = (ConcurrentQueueObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  if (MUTEX_INIT(self->head_mutex) || MUTEX_INIT(self->tail_mutex) ||
+      COND_INIT(self->not_empty)) {
+    PyErr_SetString(PyExc_RuntimeError, "Failed to initialize locks.");
+    Py_DECREF(self);
+    return NULL;
+  }
+  ConcurrentQueueNode* dummy = PyMem_Malloc(sizeof(ConcurrentQueueNode));
+  if (dummy == NULL) {
+    Py_DECREF(self);
+    return PyErr_NoMemory();
+  }
+  dummy->value = NULL;
+  dummy->next = NULL;
+  self->head = dummy;
+  self->tail = dummy;
+  self->size = 0;
+  self->waiters = 0;
+  self->flags = 0;
+  return (PyObject*)self;
+}
+
+static int ConcurrentQueue_clear(ConcurrentQueueObject* self) {
+  ConcurrentQueueNode* node = self->head;
+  self->head = NULL;
+  self->tail = NULL;
+  while (node != NULL) {
+    ConcurrentQueueNode* next = node->next;
+    Py_XDECREF(node->value);
+    PyMem_Free(node);
+    node = next;
+  }
+  return 0;
+}
+
+static int ConcurrentQueue_traverse(
+    ConcurrentQueueObject* self,
+    visitproc visit,
+    void* arg) {
+  for (ConcurrentQueueNode* node = self->head; node != NULL;
+       node = node->next) {
+    Py_VISIT(node->value);
+  }
+  return 0;
+}
+
+static void ConcurrentQueue_dealloc(ConcurrentQueueObject* self) {
+  PyObject_GC_UnTrack(self);
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  (void)ConcurrentQueue_clear(self);
+  if (MUTEX_DESTROY(self->head_mutex) || MUTEX_DESTROY(self->tail_mutex) ||
+      COND_DESTROY(self->not_empty)) {
+    Py_FatalError("Failed to destroy ConcurrentQueue locks.");
+  }
+  PyObject_GC_Del(self);
+}
+
+static PyObject* ConcurrentQueue_push(
+    ConcurrentQueueObject* self,
+    PyObject* value) {
+  if (_Py_atomic_load_int32(&self->flags) & CONCURRENT_QUEUE_SHUTDOWN) {
+    PyObject* exc = ConcurrentQueue_shutdown_error();
+    if (exc != NULL) {
+      PyErr_SetNone(exc);
+    }
+    return NULL;
+  }
+  ConcurrentQueueNode* node = PyMem_Malloc(sizeof(ConcurrentQueueNode));
+  if (node == NULL) {
+    return PyErr_NoMemory();
+  }
+  node->value = Py_NewRef(value);
+  node->next = NULL;
+
+  Py_BEGIN_ALLOW_THREADS;
+  MUTEX_LOCK(self->tail_mutex);
+  _Py_atomic_store_ptr((void**)&self->tail->next, node);
+  self->tail = node;
+  MUTEX_UNLOCK(self->tail_mutex);
+  _Py_atomic_add_int64(&self->size, 1);
+  /* Only pay for the head lock when a popper is (or is about to be)
+   * parked. The seq_cst ordering of the store above against the load here
+   * pairs with the popper incrementing waiters before it re-checks the
+   * queue, so a wakeup cannot be lost.
+   */
+  if (_Py_atomic_load_int64(&self->waiters) > 0) {
+    MUTEX_LOCK(self->head_mutex);
+    COND_SIGNAL(self->not_empty);
+    MUTEX_UNLOCK(self->head_mutex);
+  }
+  Py_END_ALLOW_THREADS;
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentQueue_pop(
+    ConcurrentQueueObject* self,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"timeout", NULL};
+  PyObject* timeout_obj = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &timeout_obj)) {
+    return NULL;
+  }
+  int64_t timeout_us = -1;
+  if (timeout_obj != Py_None) {
+    double timeout = PyFloat_AsDouble(timeout_obj);
+    if (timeout == -1.0 && PyErr_Occurred()) {
+      return NULL;
+    }
+    if (timeout < 0) {
+      PyErr_SetString(PyExc_ValueError, "timeout must be non-negative");
+      return NULL;
+    }
+    timeout_us = (int64_t)(timeout * 1000000.0);
+  }
+
+  enum ConcurrentQueuePopStatus status = CONCURRENT_QUEUE_POP_OK;
+  ConcurrentQueueNode* dummy = NULL;
+  PyObject* value = NULL;
+  ustimestamp_t start = us_time();
+
+  Py_BEGIN_ALLOW_THREADS;
+  MUTEX_LOCK(self->head_mutex);
+  _Py_atomic_add_int64(&self->waiters, 1);
+  for (;;) {
+    int32_t flags = _Py_atomic_load_int32(&self->flags);
+    if (flags & CONCURRENT_QUEUE_SHUT_NOW) {
+      status = CONCURRENT_QUEUE_POP_SHUTDOWN;
+      break;
+    }
+    ConcurrentQueueNode* node = _Py_atomic_load_ptr(&self->head->next);
+    if (node != NULL) {
+      /* The popped node becomes the new dummy; the old dummy is freed once
+       * the thread state is reattached. */
+      value = node->value;
+      node->value = NULL;
+      dummy = self->head;
+      self->head = node;
+      _Py_atomic_add_int64(&self->size, -1);
+      break;
+    }
+    if (flags & CONCURRENT_QUEUE_SHUTDOWN) {
+      status = CONCURRENT_QUEUE_POP_SHUTDOWN;
+      break;
+    }
+    if (timeout_us < 0) {
+      COND_WAIT(self->not_empty, self->head_mutex);
+    } else {
+      int64_t remaining = timeout_us - (int64_t)us_difftime(us_time(), start);
+      if (remaining <= 0 ||
+          COND_TIMEDWAIT(self->not_empty, self->head_mutex, remaining)) {
+        /* Re-check once: the signal may have raced the timeout. */
+        if (_Py_atomic_load_ptr(&self->head->next) == NULL) {
+          status = CONCURRENT_QUEUE_POP_TIMEOUT;
+          break;
+        }
+      }
+    }
+  }
+  _Py_atomic_add_int64(&self->waiters, -1);
+  MUTEX_UNLOCK(self->head_mutex);
+  Py_END_ALLOW_THREADS;
+
+  if (status == CONCURRENT_QUEUE_POP_SHUTDOWN) {
+    PyObject* exc = ConcurrentQueue_shutdown_error();
+    if (exc != NULL) {
+      PyErr_SetNone(exc);
+    }
+    return NULL;
+  }
+  if (status == CONCURRENT_QUEUE_POP_TIMEOUT) {
+    PyObject* exc = ConcurrentQueue_empty_error();
+    if (exc != NULL) {
+      PyErr_SetNone(exc);
+    }
+    return NULL;
+  }
+  PyMem_Free(dummy);
+  return value;
+}
+
+static PyObject* ConcurrentQueue_shutdown(
+    ConcurrentQueueObject* self,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"immediate", NULL};
+  int immediate = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &immediate)) {
+    return NULL;
+  }
+  int32_t flags = CONCURRENT_QUEUE_SHUTDOWN;
+  if (immediate) {
+    flags |= CONCURRENT_QUEUE_SHUT_NOW;
+  }
+  Py_BEGIN_ALLOW_THREADS;
+  _Py_atomic_or_uint32((uint32_t*)&self->flags, (uint32_t)flags);
+  MUTEX_LOCK(self->head_mutex);
+  COND_BROADCAST(self->not_empty);
+  MUTEX_UNLOCK(self->head_mutex);
+  Py_END_ALLOW_THREADS;
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentQueue_size(
+    ConcurrentQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  return PyLong_FromLongLong(_Py_atomic_load_int64(&self->size));
+}
+
+static PyObject* ConcurrentQueue_empty(
+    ConcurrentQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  return PyBool_FromLong(_Py_atomic_load_int64(&self->size) <= 0);
+}
+
+static PyMethodDef ConcurrentQueue_methods[] = {
+    {"push",
+     (PyCFunction)ConcurrentQueue_push,
+     METH_O,
+     PyDoc_STR(
+         "Q.push(value) -> None. Append a value to the back of the queue. Raises ShutDown if the queue is shut down.")},
+    {"pop",
+     (PyCFunction)ConcurrentQueue_pop,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "Q.pop(timeout=None) -> value. Remove and return the front value, parking on a condition variable while the queue is empty. Raises Empty on timeout and ShutDown once the queue is shut down and drained.")},
+    {"shutdown",
+     (PyCFunction)ConcurrentQueue_shutdown,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "Q.shutdown(immediate=False) -> None. Stop the queue accepting pushes and wake all waiters. With immediate=True pending values are not drained by pop.")},
+    {"size",
+     (PyCFunction)ConcurrentQueue_size,
+     METH_NOARGS,
+     PyDoc_STR("Return the number of values in the queue.")},
+    {"empty",
+     (PyCFunction)ConcurrentQueue_empty,
+     METH_NOARGS,
+     PyDoc_STR("Return True if the queue is empty.")},
+    {NULL, NULL, 0, NULL}};
+
+PyTypeObject ConcurrentQueueType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "_concurrency.ConcurrentQueue",
+    .tp_doc = "Concurrent FIFO queue with condition-variable blocking pops",
+    .tp_basicsize = sizeof(ConcurrentQueueObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_methods = ConcurrentQueue_methods,
+    .tp_new = ConcurrentQueue_new,
+    .tp_dealloc = (destructor)ConcurrentQueue_dealloc,
+    .tp_traverse = (traverseproc)ConcurrentQueue_traverse,
+    .tp_clear = (inquiry)ConcurrentQueue_clear,
+    .tp_weaklistoffset = offsetof(ConcurrentQueueObject, weakreflist),
+};
@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <Python.h>
+
+extern PyTypeObject ConcurrentQueueType;
+
+#endif /* CONCURRENT_QUEUE_H */
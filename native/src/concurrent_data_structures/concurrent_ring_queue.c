@@ -0,0 +1,511 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "concurrent_ring_queue.h"
+
+/* A bounded MPMC FIFO over a fixed ring of slots, after Vyukov's classic
+ * design: each slot carries a sequence number that tells producers and
+ * consumers whose turn the slot is, so the common-case push and pop are a
+ * single CAS on a position counter plus a slot write with no allocation at
+ * all. The enqueue and dequeue positions live on their own cache lines so
+ * producers and consumers do not false-share.
+ *
+ * Blocking behaviour mirrors ConcurrentQueue: pop parks on a condition
+ * variable while empty, push parks while full, and neither touches the
+ * mutex unless a waiter is actually parked.
+ */
+
+#define CONCURRENT_RING_QUEUE_PAD 64
+
+typedef struct {
+  uint64_t sequence;
+  PyObject* value;
+} ConcurrentRingQueueSlot;
+
+#define CONCURRENT_RING_QUEUE_SHUTDOWN 1
+#define CONCURRENT_RING_QUEUE_SHUT_NOW 2
+
+typedef struct {
+  PyObject_HEAD ConcurrentRingQueueSlot* slots;
+  uint64_t mask; /* capacity - 1; capacity is a power of two */
+  char _pad0[CONCURRENT_RING_QUEUE_PAD];
+  uint64_t enqueue_pos;
+  char _pad1[CONCURRENT_RING_QUEUE_PAD];
+  uint64_t dequeue_pos;
+  char _pad2[CONCURRENT_RING_QUEUE_PAD];
+  MUTEX_TYPE mutex;
+  COND_TYPE not_empty;
+  COND_TYPE not_full;
+  int64_t pop_waiters;
+  int64_t push_waiters;
+  int32_t flags;
+  PyObject* weakreflist;
+} ConcurrentRingQueueObject;
+
+enum ConcurrentRingQueueStatus {
+  CONCURRENT_RING_QUEUE_OK,
+  CONCURRENT_RING_QUEUE_AGAIN, /* full on push, empty on pop */
+  CONCURRENT_RING_QUEUE_TIMEOUT,
+  CONCURRENT_RING_QUEUE_SHUTDOWN_HIT,
+};
+
+static PyObject* ConcurrentRingQueue_exception(
+    const char* module_name,
+    const char* attr_name,
+    PyObject** cache) {
+  if (*cache == NULL) {
+    PyObject* module = PyImport_ImportModule(module_name);
+    if (module == NULL) {
+      return NULL;
+    }
+    *cache = PyObject_GetAttrString(module, attr_name);
+    Py_DECREF(module);
+  }
+  return *cache;
+}
+
+static void ConcurrentRingQueue_raise_shutdown(void) {
+  static PyObject* exc = NULL;
+  PyObject* shutdown =
+      ConcurrentRingQueue_exception("ft_utils.concurrency", "ShutDown", &exc);
+  if (shutdown != NULL) {
+    PyErr_SetNone(shutdown);
+  }
+}
+
+static void ConcurrentRingQueue_raise_queue_error(const char* attr_name) {
+  static PyObject* empty_exc = NULL;
+  static PyObject* full_exc = NULL;
+  PyObject** cache = attr_name[0] == 'E' ? &empty_exc : &full_exc;
+  PyObject* exc = ConcurrentRingQueue_exception("queue", attr_name, cache);
+  if (exc != NULL) {
+    PyErr_SetNone(exc);
+  }
+}
+
+/* Try to claim a slot and store value. No Python API calls, so this is safe
+ * to run with the thread state detached. */
+static enum ConcurrentRingQueueStatus ConcurrentRingQueue_try_push(
+    ConcurrentRingQueueObject* self,
+    PyObject* value) {
+  uint64_t pos = _Py_atomic_load_uint64(&self->enqueue_pos);
+  for (;;) {
+    ConcurrentRingQueueSlot* slot = &self->slots[pos & self->mask];
+    uint64_t seq = _Py_atomic_load_uint64(&slot->sequence);
+    int64_t dif = (int64_t)(seq - pos);
+    if (dif == 0) {
+      uint64_t expected = pos;
+      if (_Py_atomic_compare_exchange_uint64(
+              &self->enqueue_pos, &expected, pos + 1)) {
+        slot->value = value;
+        _Py_atomic_store_uint64(&slot->sequence, pos + 1);
+        return CONCURRENT_RING_QUEUE_OK;
+      }
+      pos = _Py_atomic_load_uint64(&self->enqueue_pos);
+    } else if (dif < 0) {
+      return CONCURRENT_RING_QUEUE_AGAIN;
+    } else {
+      pos = _Py_atomic_load_uint64(&self->enqueue_pos);
+    }
+  }
+}
+
+/* Try to take the front value. No Python API calls; refcounting happens in
+ * the caller once the thread state is reattached. */
+static enum ConcurrentRingQueueStatus ConcurrentRingQueue_try_pop(
+    ConcurrentRingQueueObject* self,
+    PyObject** value) {
+  uint64_t pos = _Py_atomic_load_uint64(&self->dequeue_pos);
+  for (;;) {
+    ConcurrentRingQueueSlot* slot = &self->slots[pos & self->mask];
+    uint64_t seq = _Py_atomic_load_uint64(&slot->sequence);
+    int64_t dif = (int64_t)(seq - (pos + 1));
+    if (dif == 0) {
+      uint64_t expected = pos;
+      if (_Py_atomic_compare_exchange_uint64(
+              &self->dequeue_pos, &expected, pos + 1)) {
+        *value = slot->value;
+        slot->value = NULL;
+        _Py_atomic_store_uint64(&slot->sequence, pos + self->mask + 1);
+        return CONCURRENT_RING_QUEUE_OK;
+      }
+      pos = _Py_atomic_load_uint64(&self->dequeue_pos);
+    } else if (dif < 0) {
+      return CONCURRENT_RING_QUEUE_AGAIN;
+    } else {
+      pos = _Py_atomic_load_uint64(&self->dequeue_pos);
+    }
+  }
+}
+
+static PyObject*
+ConcurrentRingQueue_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = {"capacity", NULL};
+  Py_ssize_t capacity = 1024;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &capacity)) {
+    return NULL;
+  }
+  if (capacity <= 0) {
+    PyErr_SetString(PyExc_ValueError, "capacity must be positive");
+    return NULL;
+  }
+  /* Round up to a power of two so slot selection is a mask. The minimum is
+   * two slots: with a single slot the sequence value meaning "ready for the
+   * next enqueue" collides with the one meaning "occupied".
+   */
+  uint64_t rounded = 2;
+  while (rounded < (uint64_t)capacity) {
+    rounded <<= 1;
+  }
+
+  ConcurrentRingQueueObject* self =
+      (ConcurrentRingQueueObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  if (MUTEX_INIT(self->mutex) || COND_INIT(self->not_empty) ||
+      COND_INIT(self->not_full)) {
+    PyErr_SetString(PyExc_RuntimeError, "Failed to initialize locks.");
+    Py_DECREF(self);
+    return NULL;
+  }
+  self->slots =
+      PyMem_Calloc((size_t)rounded, sizeof(ConcurrentRingQueueSlot));
+  if (self->slots == NULL) {
+    Py_DECREF(self);
+    return PyErr_NoMemory();
+  }
+  for (uint64_t i = 0; i < rounded; i++) {
+    self->slots[i].sequence = i;
+  }
+  self->mask = rounded - 1;
+  self->enqueue_pos = 0;
+  self->dequeue_pos = 0;
+  self->pop_waiters = 0;
+  self->push_waiters = 0;
+  self->flags = 0;
+  return (PyObject*)self;
+}
+
+static int ConcurrentRingQueue_gc_clear(ConcurrentRingQueueObject* self) {
+  if (self->slots != NULL) {
+    for (uint64_t i = 0; i <= self->mask; i++) {
+      Py_CLEAR(self->slots[i].value);
+    }
+    PyMem_Free(self->slots);
+    self->slots = NULL;
+  }
+  return 0;
+}
+
+static int ConcurrentRingQueue_traverse(
+    ConcurrentRingQueueObject* self,
+    visitproc visit,
+    void* arg) {
+  if (self->slots != NULL) {
+    for (uint64_t i = 0; i <= self->mask; i++) {
+      Py_VISIT(self->slots[i].value);
+    }
+  }
+  return 0;
+}
+
+static void ConcurrentRingQueue_dealloc(ConcurrentRingQueueObject* self) {
+  PyObject_GC_UnTrack(self);
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  (void)ConcurrentRingQueue_gc_clear(self);
+  if (MUTEX_DESTROY(self->mutex) || COND_DESTROY(self->not_empty) ||
+      COND_DESTROY(self->not_full)) {
+    Py_FatalError("Failed to destroy ConcurrentRingQueue locks.");
+  }
+  PyObject_GC_Del(self);
+}
+
+static int ConcurrentRingQueue_parse_timeout(
+    PyObject* timeout_obj,
+    int64_t* timeout_us) {
+  *timeout_us = -1;
+  if (timeout_obj != Py_None) {
+    double timeout = PyFloat_AsDouble(timeout_obj);
+    if (timeout == -1.0 && PyErr_Occurred()) {
+      return -1;
+    }
+    if (timeout < 0) {
+      PyErr_SetString(PyExc_ValueError, "timeout must be non-negative");
+      return -1;
+    }
+    *timeout_us = (int64_t)(timeout * 1000000.0);
+  }
+  return 0;
+}
+
+static PyObject* ConcurrentRingQueue_push(
+    ConcurrentRingQueueObject* self,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"value", "timeout", NULL};
+  PyObject* value;
+  PyObject* timeout_obj = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "O|O", kwlist, &value, &timeout_obj)) {
+    return NULL;
+  }
+  int64_t timeout_us;
+  if (ConcurrentRingQueue_parse_timeout(timeout_obj, &timeout_us) < 0) {
+    return NULL;
+  }
+  if (_Py_atomic_load_int32(&self->flags) & CONCURRENT_RING_QUEUE_SHUTDOWN) {
+    ConcurrentRingQueue_raise_shutdown();
+    return NULL;
+  }
+  Py_INCREF(value);
+
+  enum ConcurrentRingQueueStatus status;
+  ustimestamp_t start = us_time();
+
+  Py_BEGIN_ALLOW_THREADS;
+  status = ConcurrentRingQueue_try_push(self, value);
+  while (status == CONCURRENT_RING_QUEUE_AGAIN) {
+    MUTEX_LOCK(self->mutex);
+    _Py_atomic_add_int64(&self->push_waiters, 1);
+    status = ConcurrentRingQueue_try_push(self, value);
+    if (status == CONCURRENT_RING_QUEUE_AGAIN) {
+      if (_Py_atomic_load_int32(&self->flags) &
+          CONCURRENT_RING_QUEUE_SHUTDOWN) {
+        status = CONCURRENT_RING_QUEUE_SHUTDOWN_HIT;
+      } else if (timeout_us < 0) {
+        COND_WAIT(self->not_full, self->mutex);
+      } else {
+        int64_t remaining =
+            timeout_us - (int64_t)us_difftime(us_time(), start);
+        if (remaining <= 0 ||
+            COND_TIMEDWAIT(self->not_full, self->mutex, remaining)) {
+          status = CONCURRENT_RING_QUEUE_TIMEOUT;
+        }
+      }
+    }
+    _Py_atomic_add_int64(&self->push_waiters, -1);
+    MUTEX_UNLOCK(self->mutex);
+    if (status == CONCURRENT_RING_QUEUE_AGAIN) {
+      status = ConcurrentRingQueue_try_push(self, value);
+    } else if (status == CONCURRENT_RING_QUEUE_TIMEOUT) {
+      /* One last try: a slot may have freed up as the timeout fired. */
+      if (ConcurrentRingQueue_try_push(self, value) ==
+          CONCURRENT_RING_QUEUE_OK) {
+        status = CONCURRENT_RING_QUEUE_OK;
+      }
+    }
+  }
+  if (status == CONCURRENT_RING_QUEUE_OK &&
+      _Py_atomic_load_int64(&self->pop_waiters) > 0) {
+    MUTEX_LOCK(self->mutex);
+    COND_SIGNAL(self->not_empty);
+    MUTEX_UNLOCK(self->mutex);
+  }
+  Py_END_ALLOW_THREADS;
+
+  if (status == CONCURRENT_RING_QUEUE_SHUTDOWN_HIT) {
+    Py_DECREF(value);
+    ConcurrentRingQueue_raise_shutdown();
+    return NULL;
+  }
+  if (status == CONCURRENT_RING_QUEUE_TIMEOUT) {
+    Py_DECREF(value);
+    ConcurrentRingQueue_raise_queue_error("Full");
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentRingQueue_pop(
+    ConcurrentRingQueueObject* self,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"timeout", NULL};
+  PyObject* timeout_obj = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &timeout_obj)) {
+    return NULL;
+  }
+  int64_t timeout_us;
+  if (ConcurrentRingQueue_parse_timeout(timeout_obj, &timeout_us) < 0) {
+    return NULL;
+  }
+
+  enum ConcurrentRingQueueStatus status;
+  PyObject* value = NULL;
+  ustimestamp_t start = us_time();
+
+  Py_BEGIN_ALLOW_THREADS;
+  if (_Py_atomic_load_int32(&self->flags) & CONCURRENT_RING_QUEUE_SHUT_NOW) {
+    status = CONCURRENT_RING_QUEUE_SHUTDOWN_HIT;
+  } else {
+    status = ConcurrentRingQueue_try_pop(self, &value);
+  }
+  while (status == CONCURRENT_RING_QUEUE_AGAIN) {
+    MUTEX_LOCK(self->mutex);
+    _Py_atomic_add_int64(&self->pop_waiters, 1);
+    status = ConcurrentRingQueue_try_pop(self, &value);
+    if (status == CONCURRENT_RING_QUEUE_AGAIN) {
+      if (_Py_atomic_load_int32(&self->flags) &
+          CONCURRENT_RING_QUEUE_SHUTDOWN) {
+        status = CONCURRENT_RING_QUEUE_SHUTDOWN_HIT;
+      } else if (timeout_us < 0) {
+        COND_WAIT(self->not_empty, self->mutex);
+      } else {
+        int64_t remaining =
+            timeout_us - (int64_t)us_difftime(us_time(), start);
+        if (remaining <= 0 ||
+            COND_TIMEDWAIT(self->not_empty, self->mutex, remaining)) {
+          status = CONCURRENT_RING_QUEUE_TIMEOUT;
+        }
+      }
+    }
+    _Py_atomic_add_int64(&self->pop_waiters, -1);
+    MUTEX_UNLOCK(self->mutex);
+    if (status == CONCURRENT_RING_QUEUE_AGAIN) {
+      status = ConcurrentRingQueue_try_pop(self, &value);
+    } else if (status == CONCURRENT_RING_QUEUE_TIMEOUT) {
+      if (ConcurrentRingQueue_try_pop(self, &value) ==
+          CONCURRENT_RING_QUEUE_OK) {
+        status = CONCURRENT_RING_QUEUE_OK;
+      }
+    } else if (status == CONCURRENT_RING_QUEUE_SHUTDOWN_HIT) {
+      /* Drain pending values on a non-immediate shutdown. */
+      if (!(_Py_atomic_load_int32(&self->flags) &
+            CONCURRENT_RING_QUEUE_SHUT_NOW) &&
+          ConcurrentRingQueue_try_pop(self, &value) ==
+              CONCURRENT_RING_QUEUE_OK) {
+        status = CONCURRENT_RING_QUEUE_OK;
+      }
+    }
+  }
+  if (status == CONCURRENT_RING_QUEUE_OK &&
+      _Py_atomic_load_int64(&self->push_waiters) > 0) {
+    MUTEX_LOCK(self->mutex);
+    COND_SIGNAL(self->not_full);
+    MUTEX_UNLOCK(self->mutex);
+  }
+  Py_END_ALLOW_THREADS;
+
+  if (status == CONCURRENT_RING_QUEUE_SHUTDOWN_HIT) {
+    ConcurrentRingQueue_raise_shutdown();
+    return NULL;
+  }
+  if (status == CONCURRENT_RING_QUEUE_TIMEOUT) {
+    ConcurrentRingQueue_raise_queue_error("Empty");
+    return NULL;
+  }
+  return value;
+}
+
+static PyObject* ConcurrentRingQueue_shutdown(
+    ConcurrentRingQueueObject* self,
+    PyObject* args,
+    PyObject* kwds) {
+  static char* kwlist[] = {"immediate", NULL};
+  int immediate = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &immediate)) {
+    return NULL;
+  }
+  int32_t flags = CONCURRENT_RING_QUEUE_SHUTDOWN;
+  if (immediate) {
+    flags |= CONCURRENT_RING_QUEUE_SHUT_NOW;
+  }
+  Py_BEGIN_ALLOW_THREADS;
+  _Py_atomic_or_uint32((uint32_t*)&self->flags, (uint32_t)flags);
+  MUTEX_LOCK(self->mutex);
+  COND_BROADCAST(self->not_empty);
+  COND_BROADCAST(self->not_full);
+  MUTEX_UNLOCK(self->mutex);
+  Py_END_ALLOW_THREADS;
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentRingQueue_size(
+    ConcurrentRingQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  /* The two counters are read independently so the result is approximate
+   * under concurrent churn, like ConcurrentQueue.size(). */
+  uint64_t enqueue = _Py_atomic_load_uint64(&self->enqueue_pos);
+  uint64_t dequeue = _Py_atomic_load_uint64(&self->dequeue_pos);
+  int64_t size = (int64_t)(enqueue - dequeue);
+  if (size < 0) {
+    size = 0;
+  }
+  return PyLong_FromLongLong(size);
+}
+
+static PyObject* ConcurrentRingQueue_capacity(
+    ConcurrentRingQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  return PyLong_FromUnsignedLongLong(self->mask + 1);
+}
+
+static PyObject* ConcurrentRingQueue_empty(
+    ConcurrentRingQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  uint64_t enqueue = _Py_atomic_load_uint64(&self->enqueue_pos);
+  uint64_t dequeue = _Py_atomic_load_uint64(&self->dequeue_pos);
+  return PyBool_FromLong(enqueue == dequeue);
+}
+
+static PyObject* ConcurrentRingQueue_full(
+    ConcurrentRingQueueObject* self,
+    PyObject* Py_UNUSED(args)) {
+  uint64_t enqueue = _Py_atomic_load_uint64(&self->enqueue_pos);
+  uint64_t dequeue = _Py_atomic_load_uint64(&self->dequeue_pos);
+  return PyBool_FromLong(enqueue - dequeue > self->mask);
+}
+
+static PyMethodDef ConcurrentRingQueue_methods[] = {
+    {"push",
+     (PyCFunction)ConcurrentRingQueue_push,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "Q.push(value, timeout=None) -> None. Append to the ring, parking while full. Raises Full on timeout and ShutDown if the queue is shut down.")},
+    {"pop",
+     (PyCFunction)ConcurrentRingQueue_pop,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "Q.pop(timeout=None) -> value. Remove and return the front value, parking while empty. Raises Empty on timeout and ShutDown once the queue is shut down and drained.")},
+    {"shutdown",
+     (PyCFunction)ConcurrentRingQueue_shutdown,
+     METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR(
+         "Q.shutdown(immediate=False) -> None. Stop the queue accepting pushes and wake all waiters. With immediate=True pending values are not drained by pop.")},
+    {"size",
+     (PyCFunction)ConcurrentRingQueue_size,
+     METH_NOARGS,
+     PyDoc_STR("Return the approximate number of values in the ring.")},
+    {"capacity",
+     (PyCFunction)ConcurrentRingQueue_capacity,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Return the ring capacity (the requested capacity rounded up to a power of two).")},
+    {"empty",
+     (PyCFunction)ConcurrentRingQueue_empty,
+     METH_NOARGS,
+     PyDoc_STR("Return True if the ring is empty.")},
+    {"full",
+     (PyCFunction)ConcurrentRingQueue_full,
+     METH_NOARGS,
+     PyDoc_STR("Return True if the ring is full.")},
+    {NULL, NULL, 0, NULL}};
+
+PyTypeObject ConcurrentRingQueueType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name =
+        "_concurrency.ConcurrentRingQueue",
+    .tp_doc = "Bounded MPMC ring-buffer queue",
+    .tp_basicsize = sizeof(ConcurrentRingQueueObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_methods = ConcurrentRingQueue_methods,
+    .tp_new = ConcurrentRingQueue_new,
+    .tp_dealloc = (destructor)ConcurrentRingQueue_dealloc,
+    .tp_traverse = (traverseproc)ConcurrentRingQueue_traverse,
+    .tp_clear = (inquiry)ConcurrentRingQueue_gc_clear,
+    .tp_weaklistoffset = offsetof(ConcurrentRingQueueObject, weakreflist),
+};
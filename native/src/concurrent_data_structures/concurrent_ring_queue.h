@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef CONCURRENT_RING_QUEUE_H
+#define CONCURRENT_RING_QUEUE_H
+
+#include <Python.h>
+
+extern PyTypeObject ConcurrentRingQueueType;
+
+#endif /* CONCURRENT_RING_QUEUE_H */
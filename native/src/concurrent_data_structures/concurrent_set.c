@@ -0,0 +1,978 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "concurrent_set.h"
+
+/* A sharded concurrent set. The layout mirrors ConcurrentDict — a table of
+ * bucket objects published by pointer swap, with cooperative incremental
+ * migration during a grow — but the buckets are PySets, so each element
+ * costs a key slot only rather than a key and a value pointer. Membership
+ * tests hash once to pick a shard and then probe that shard's set.
+ */
+typedef struct ConcurrentSetTable {
+  Py_ssize_t size;
+  PyObject** buckets;
+  /* Link in the owning set's retired list once fully drained. */
+  struct ConcurrentSetTable* next_retired;
+} ConcurrentSetTable;
+
+typedef struct {
+  PyObject_HEAD ConcurrentSetTable* table;
+  /* Non-NULL only while a grow is in progress; see ConcurrentDict. */
+  ConcurrentSetTable* old_table;
+  /* Fully drained tables, kept allocated until the set dies so the
+   * lock-free table and bucket pointer reads in keyed operations never
+   * touch freed memory; see ConcurrentDictObject.retired. */
+  ConcurrentSetTable* retired;
+  Py_ssize_t migrated; /* buckets of old_table fully migrated */
+  Py_ssize_t next_migrate; /* next old bucket index to sweep */
+  int growable;
+  MUTEX_TYPE grow_mutex;
+  PyObject* weakreflist;
+} ConcurrentSetObject;
+
+/* Average elements per shard before a growable set triggers a grow. */
+#define CONCURRENT_SET_MAX_SHARD_LOAD 64
+/* How many extra old buckets each keyed operation migrates. */
+#define CONCURRENT_SET_MIGRATE_STRIDE 2
+/* Shard count multiplier on grow. */
+#define CONCURRENT_SET_GROWTH_FACTOR 4
+
+/* Same fast-path hashing as ConcurrentDict_key_hash: reuse the cached hash
+ * of exact strs and call the int tp_hash slot directly, keeping subclasses
+ * with overridden __hash__ on the generic path.
+ */
+static inline Py_hash_t ConcurrentSet_key_hash(PyObject* key) {
+  if (PyUnicode_CheckExact(key)) {
+    Py_hash_t hash =
+        _Py_atomic_load_ssize_relaxed(&((PyASCIIObject*)key)->hash);
+    if (hash != -1) {
+      return hash;
+    }
+    return PyObject_Hash(key);
+  }
+  if (PyLong_CheckExact(key)) {
+    return PyLong_Type.tp_hash(key);
+  }
+  return PyObject_Hash(key);
+}
+
+static ConcurrentSetTable* ConcurrentSetTable_alloc(Py_ssize_t size) {
+  ConcurrentSetTable* table = PyMem_Malloc(sizeof(ConcurrentSetTable));
+  if (table == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  table->buckets = (PyObject**)PyMem_Calloc(size, sizeof(PyObject*));
+  if (table->buckets == NULL) {
+    PyMem_Free(table);
+    PyErr_NoMemory();
+    return NULL;
+  }
+  table->size = size;
+  table->next_retired = NULL;
+  for (Py_ssize_t i = 0; i < size; i++) {
+    table->buckets[i] = PySet_New(NULL);
+    if (table->buckets[i] == NULL) {
+      for (Py_ssize_t j = 0; j < i; j++) {
+        Py_DECREF(table->buckets[j]);
+      }
+      PyMem_Free(table->buckets);
+      PyMem_Free(table);
+      return NULL;
+    }
+  }
+  return table;
+}
+
+static void ConcurrentSetTable_dealloc(ConcurrentSetTable* table) {
+  if (table == NULL) {
+    return;
+  }
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    Py_CLEAR(table->buckets[i]);
+  }
+  PyMem_Free(table->buckets);
+  PyMem_Free(table);
+}
+
+static inline Py_ssize_t ConcurrentSetTable_index(
+    ConcurrentSetTable* table,
+    Py_hash_t hash) {
+  Py_ssize_t index = hash % table->size;
+  if (index < 0) {
+    index = -index;
+  }
+  return index;
+}
+
+/* Move every element of old bucket i into the current table. Must be called
+ * with grow_mutex held. Returns -1 on error.
+ */
+static int ConcurrentSet_migrate_bucket(
+    ConcurrentSetObject* self,
+    Py_ssize_t i) {
+  PyObject* bucket = self->old_table->buckets[i];
+  if (PySet_Size(bucket) == 0) {
+    return 0;
+  }
+  /* Iterate a private copy so the bucket can change under the walk. A
+   * writer racing the grow can re-populate the bucket after the clear
+   * below; it notices the table swap once its operation completes and
+   * retries through ConcurrentSet_shard, which re-runs this migration for
+   * any old bucket that is not empty.
+   */
+  PyObject* copy = PySet_New(bucket);
+  if (copy == NULL) {
+    return -1;
+  }
+  PyObject* iter = PyObject_GetIter(copy);
+  Py_DECREF(copy);
+  if (iter == NULL) {
+    return -1;
+  }
+  PyObject* key;
+  while ((key = PyIter_Next(iter)) != NULL) {
+    Py_hash_t hash = ConcurrentSet_key_hash(key);
+    if (hash == -1 && PyErr_Occurred()) {
+      Py_DECREF(key);
+      Py_DECREF(iter);
+      return -1;
+    }
+    Py_ssize_t index = ConcurrentSetTable_index(self->table, hash);
+    int rc = PySet_Add(self->table->buckets[index], key);
+    Py_DECREF(key);
+    if (rc < 0) {
+      Py_DECREF(iter);
+      return -1;
+    }
+  }
+  Py_DECREF(iter);
+  if (PyErr_Occurred()) {
+    return -1;
+  }
+  PySet_Clear(bucket);
+  return 0;
+}
+
+/* Unhook a fully drained old_table. Must be called with grow_mutex held.
+ * Retired rather than freed so racing lock-free readers stay safe; see
+ * ConcurrentDict_retire_old_table.
+ */
+static void ConcurrentSet_retire_old_table(ConcurrentSetObject* self) {
+  ConcurrentSetTable* old = self->old_table;
+  _Py_atomic_store_ptr((void**)&self->old_table, NULL);
+  old->next_retired = self->retired;
+  self->retired = old;
+}
+
+/* Help an in-progress grow along and return a new reference to the bucket
+ * the given hash lives in within the current table, recording the table it
+ * came from in *table_used. Every keyed operation routes through here so
+ * the rehash cost is spread across callers. Callers must re-check the
+ * table pointer after their set operation (ConcurrentSet_table_stale) and
+ * retry if a grow republished it, because the bucket may have drained
+ * mid-operation.
+ */
+static PyObject* ConcurrentSet_shard(
+    ConcurrentSetObject* self,
+    Py_hash_t hash,
+    ConcurrentSetTable** table_used) {
+  if (_Py_atomic_load_ptr(&self->old_table) != NULL) {
+    MUTEX_LOCK(self->grow_mutex);
+    ConcurrentSetTable* old = self->old_table;
+    if (old != NULL) {
+      Py_ssize_t index = ConcurrentSetTable_index(old, hash);
+      if (old->buckets[index] != NULL && PySet_Size(old->buckets[index]) != 0) {
+        if (ConcurrentSet_migrate_bucket(self, index) < 0) {
+          MUTEX_UNLOCK(self->grow_mutex);
+          return NULL;
+        }
+      }
+      for (int step = 0; step < CONCURRENT_SET_MIGRATE_STRIDE &&
+           self->next_migrate < old->size;
+           step++) {
+        if (ConcurrentSet_migrate_bucket(self, self->next_migrate) < 0) {
+          MUTEX_UNLOCK(self->grow_mutex);
+          return NULL;
+        }
+        self->next_migrate++;
+        self->migrated++;
+      }
+      if (self->migrated >= old->size) {
+        ConcurrentSet_retire_old_table(self);
+      }
+    }
+    MUTEX_UNLOCK(self->grow_mutex);
+  }
+  ConcurrentSetTable* table = _Py_atomic_load_ptr(&self->table);
+  *table_used = table;
+  return Py_NewRef(table->buckets[ConcurrentSetTable_index(table, hash)]);
+}
+
+/* True if a grow republished the table after a keyed operation picked its
+ * bucket; the operation must then retry against the current table.
+ */
+static inline int ConcurrentSet_table_stale(
+    ConcurrentSetObject* self,
+    ConcurrentSetTable* table_used) {
+  return _Py_atomic_load_ptr(&self->table) != table_used;
+}
+
+/* Complete any in-progress grow. Used by whole-set operations which are
+ * simpler and no slower against a single table.
+ */
+static int ConcurrentSet_finish_grow(ConcurrentSetObject* self) {
+  if (_Py_atomic_load_ptr(&self->old_table) == NULL) {
+    return 0;
+  }
+  MUTEX_LOCK(self->grow_mutex);
+  ConcurrentSetTable* old = self->old_table;
+  if (old != NULL) {
+    while (self->next_migrate < old->size) {
+      if (ConcurrentSet_migrate_bucket(self, self->next_migrate) < 0) {
+        MUTEX_UNLOCK(self->grow_mutex);
+        return -1;
+      }
+      self->next_migrate++;
+      self->migrated++;
+    }
+    ConcurrentSet_retire_old_table(self);
+  }
+  MUTEX_UNLOCK(self->grow_mutex);
+  return 0;
+}
+
+/* Kick off a grow if the shard this element landed in has gone past the
+ * load limit. Publishing the new table is just a pointer swap.
+ */
+static int ConcurrentSet_maybe_grow(
+    ConcurrentSetObject* self,
+    PyObject* bucket) {
+  if (!self->growable || _Py_atomic_load_ptr(&self->old_table) != NULL ||
+      PySet_Size(bucket) <= CONCURRENT_SET_MAX_SHARD_LOAD) {
+    return 0;
+  }
+  MUTEX_LOCK(self->grow_mutex);
+  if (self->old_table != NULL) {
+    /* Another thread beat us to it. */
+    MUTEX_UNLOCK(self->grow_mutex);
+    return 0;
+  }
+  ConcurrentSetTable* next_table = ConcurrentSetTable_alloc(
+      self->table->size * CONCURRENT_SET_GROWTH_FACTOR + 1);
+  if (next_table == NULL) {
+    MUTEX_UNLOCK(self->grow_mutex);
+    return -1;
+  }
+  self->migrated = 0;
+  self->next_migrate = 0;
+  _Py_atomic_store_ptr((void**)&self->old_table, self->table);
+  _Py_atomic_store_ptr((void**)&self->table, next_table);
+  MUTEX_UNLOCK(self->grow_mutex);
+  return 0;
+}
+
+static int ConcurrentSet_clear(ConcurrentSetObject* self) {
+  if (self->table != NULL) {
+    ConcurrentSetTable_dealloc(self->table);
+    self->table = NULL;
+  }
+  if (self->old_table != NULL) {
+    ConcurrentSetTable_dealloc(self->old_table);
+    self->old_table = NULL;
+  }
+  while (self->retired != NULL) {
+    ConcurrentSetTable* next = self->retired->next_retired;
+    ConcurrentSetTable_dealloc(self->retired);
+    self->retired = next;
+  }
+  return 0;
+}
+
+static int ConcurrentSet_add_key(ConcurrentSetObject* self, PyObject* key) {
+  Py_hash_t hash = ConcurrentSet_key_hash(key);
+  if (hash == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  for (;;) {
+    ConcurrentSetTable* used;
+    PyObject* bucket = ConcurrentSet_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return -1;
+    }
+    int rc = PySet_Add(bucket, key);
+    if (!ConcurrentSet_table_stale(self, used)) {
+      if (rc == 0) {
+        rc = ConcurrentSet_maybe_grow(self, bucket);
+      }
+      Py_DECREF(bucket);
+      return rc;
+    }
+    /* A grow republished the table mid-add, so the element may sit in a
+     * bucket that had already drained; retry against the current table.
+     * ConcurrentSet_shard migrates this key's old bucket first, which also
+     * carries over an add left behind by this attempt.
+     */
+    if (rc < 0) {
+      PyErr_Clear();
+    } else if (_Py_atomic_load_ptr(&self->old_table) != used) {
+      /* The table this add landed in has fully drained and retired, so no
+       * migration will move the element out again; scrub it rather than
+       * leave a stray strong reference behind. Keyed operations never
+       * trust a retired bucket, so the removal is not observable.
+       */
+      if (PySet_Discard(bucket, key) < 0) {
+        PyErr_Clear();
+      }
+    }
+    Py_DECREF(bucket);
+  }
+}
+
+/* Discard key, returning 1 if an element was removed, 0 if absent and -1 on
+ * error, retrying when a grow overlaps. An attempt that removed the element
+ * just before its bucket drained still counts as a removal.
+ */
+static int ConcurrentSet_discard_key(ConcurrentSetObject* self, PyObject* key) {
+  Py_hash_t hash = ConcurrentSet_key_hash(key);
+  if (hash == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  int removed = 0;
+  for (;;) {
+    ConcurrentSetTable* used;
+    PyObject* bucket = ConcurrentSet_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return -1;
+    }
+    int rc = PySet_Discard(bucket, key);
+    Py_DECREF(bucket);
+    if (!ConcurrentSet_table_stale(self, used)) {
+      if (rc < 0) {
+        return rc;
+      }
+      return rc || removed;
+    }
+    if (rc < 0) {
+      PyErr_Clear();
+    } else if (rc == 1) {
+      removed = 1;
+    }
+  }
+}
+
+/* Add every element of an iterable. ConcurrentSet sources with a matching
+ * shard count merge bucket-by-bucket, skipping the per-element shard
+ * selection; anything else goes element-by-element through the add path.
+ */
+static int ConcurrentSet_update_internal(
+    ConcurrentSetObject* self,
+    PyObject* other) {
+  if (Py_TYPE(other) == &ConcurrentSetType) {
+    ConcurrentSetObject* other_set = (ConcurrentSetObject*)other;
+    if (ConcurrentSet_finish_grow(self) < 0 ||
+        ConcurrentSet_finish_grow(other_set) < 0) {
+      return -1;
+    }
+    ConcurrentSetTable* table = _Py_atomic_load_ptr(&self->table);
+    ConcurrentSetTable* other_table = _Py_atomic_load_ptr(&other_set->table);
+    if (table->size == other_table->size) {
+      /* Equal shard counts hash every element to the same index, so each
+       * destination bucket is the union of exactly one source bucket.
+       */
+      for (Py_ssize_t i = 0; i < table->size; i++) {
+        PyObject* merged =
+            PyNumber_InPlaceOr(table->buckets[i], other_table->buckets[i]);
+        if (merged == NULL) {
+          return -1;
+        }
+        Py_DECREF(merged);
+      }
+      return 0;
+    }
+  }
+  PyObject* iter = PyObject_GetIter(other);
+  if (iter == NULL) {
+    return -1;
+  }
+  PyObject* key;
+  while ((key = PyIter_Next(iter)) != NULL) {
+    int rc = ConcurrentSet_add_key(self, key);
+    Py_DECREF(key);
+    if (rc < 0) {
+      Py_DECREF(iter);
+      return -1;
+    }
+  }
+  Py_DECREF(iter);
+  if (PyErr_Occurred()) {
+    return -1;
+  }
+  return 0;
+}
+
+static void ConcurrentSet_dealloc(ConcurrentSetObject* self) {
+  PyObject_GC_UnTrack(self);
+  ConcurrentSet_clear(self);
+  if (MUTEX_DESTROY(self->grow_mutex)) {
+    Py_FatalError("Failed to destroy ConcurrentSet mutex.");
+  }
+  PyObject_ClearWeakRefs((PyObject*)self);
+  PyObject_GC_Del(self);
+}
+
+static PyObject*
+ConcurrentSet_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  PyObject* iterable = NULL;
+  Py_ssize_t initial_capacity = 0;
+  int growable = 0;
+  static char* kwlist[] = {"iterable", "initial_capacity", "growable", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args,
+          kwds,
+          "|Onp",
+          kwlist,
+          &iterable,
+          &initial_capacity,
+          &growable)) {
+    return NULL;
+  }
+
+  if (initial_capacity <= 0) {
+    // Random prime number chosen to reduce collision in buckets
+    initial_capacity = 17;
+  }
+
+  ConcurrentSetObject* self = (ConcurrentSetObject*)type->tp_alloc(type, 0);
+  if (self != NULL) {
+    if (MUTEX_INIT(self->grow_mutex)) {
+      PyErr_SetString(PyExc_RuntimeError, "Failed to initialize locks.");
+      Py_DECREF(self);
+      return NULL;
+    }
+    self->old_table = NULL;
+    self->retired = NULL;
+    self->migrated = 0;
+    self->next_migrate = 0;
+    self->growable = growable;
+    self->table = ConcurrentSetTable_alloc(initial_capacity);
+    if (self->table == NULL) {
+      Py_DECREF(self);
+      return NULL;
+    }
+
+    if (iterable != NULL && iterable != Py_None) {
+      if (ConcurrentSet_update_internal(self, iterable) < 0) {
+        Py_DECREF(self);
+        return NULL;
+      }
+    }
+  }
+  return (PyObject*)self;
+}
+
+/* Create an empty set with the given shard count, for union/intersection
+ * results.
+ */
+static ConcurrentSetObject* ConcurrentSet_new_sized(
+    Py_ssize_t capacity,
+    int growable) {
+  PyObject* args = Py_BuildValue("(Oni)", Py_None, capacity, growable);
+  if (args == NULL) {
+    return NULL;
+  }
+  PyObject* result = ConcurrentSet_new(&ConcurrentSetType, args, NULL);
+  Py_DECREF(args);
+  return (ConcurrentSetObject*)result;
+}
+
+static PyObject* ConcurrentSet_add(ConcurrentSetObject* self, PyObject* key) {
+  if (ConcurrentSet_add_key(self, key) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentSet_discard(
+    ConcurrentSetObject* self,
+    PyObject* key) {
+  if (ConcurrentSet_discard_key(self, key) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* ConcurrentSet_remove(
+    ConcurrentSetObject* self,
+    PyObject* key) {
+  int rc = ConcurrentSet_discard_key(self, key);
+  if (rc < 0) {
+    return NULL;
+  }
+  if (rc == 0) {
+    PyErr_SetObject(PyExc_KeyError, key);
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static int ConcurrentSet_contains(ConcurrentSetObject* self, PyObject* key) {
+  Py_hash_t hash = ConcurrentSet_key_hash(key);
+  if (hash == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  for (;;) {
+    ConcurrentSetTable* used;
+    PyObject* bucket = ConcurrentSet_shard(self, hash, &used);
+    if (bucket == NULL) {
+      return -1;
+    }
+    int rc = PySet_Contains(bucket, key);
+    Py_DECREF(bucket);
+    /* A hit is always good; a miss against a bucket a concurrent grow may
+     * have drained says nothing about the current table, so retry. */
+    if (rc != 0 || !ConcurrentSet_table_stale(self, used)) {
+      return rc;
+    }
+  }
+}
+
+static PyObject* ConcurrentSet_update(
+    ConcurrentSetObject* self,
+    PyObject* other) {
+  if (ConcurrentSet_update_internal(self, other) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* Return a new ConcurrentSet with the elements of both sets. When the other
+ * side is a ConcurrentSet, the merge runs shard-by-shard. Not thread
+ * consistent.
+ */
+static PyObject* ConcurrentSet_union(
+    ConcurrentSetObject* self,
+    PyObject* other) {
+  if (ConcurrentSet_finish_grow(self) < 0) {
+    return NULL;
+  }
+  ConcurrentSetTable* table = _Py_atomic_load_ptr(&self->table);
+  ConcurrentSetObject* result =
+      ConcurrentSet_new_sized(table->size, self->growable);
+  if (result == NULL) {
+    return NULL;
+  }
+  if (ConcurrentSet_update_internal(result, (PyObject*)self) < 0 ||
+      ConcurrentSet_update_internal(result, other) < 0) {
+    Py_DECREF(result);
+    return NULL;
+  }
+  return (PyObject*)result;
+}
+
+/* Return a new ConcurrentSet with the elements common to both sides. Each
+ * shard of this set is intersected independently, probing the other side
+ * for membership. Not thread consistent.
+ */
+static PyObject* ConcurrentSet_intersection(
+    ConcurrentSetObject* self,
+    PyObject* other) {
+  if (ConcurrentSet_finish_grow(self) < 0) {
+    return NULL;
+  }
+  /* Probe the other side per element; a plain set (or anything supporting
+   * "in") works as well as a ConcurrentSet.
+   */
+  PyObject* other_probe = other;
+  PyObject* other_owned = NULL;
+  if (Py_TYPE(other) != &ConcurrentSetType && !PyAnySet_Check(other)) {
+    other_owned = PySet_New(other);
+    if (other_owned == NULL) {
+      return NULL;
+    }
+    other_probe = other_owned;
+  }
+
+  ConcurrentSetTable* table = _Py_atomic_load_ptr(&self->table);
+  ConcurrentSetObject* result =
+      ConcurrentSet_new_sized(table->size, self->growable);
+  if (result == NULL) {
+    Py_XDECREF(other_owned);
+    return NULL;
+  }
+  ConcurrentSetTable* result_table = result->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    PyObject* copy = PySet_New(table->buckets[i]);
+    if (copy == NULL) {
+      goto fail;
+    }
+    PyObject* iter = PyObject_GetIter(copy);
+    Py_DECREF(copy);
+    if (iter == NULL) {
+      goto fail;
+    }
+    PyObject* key;
+    while ((key = PyIter_Next(iter)) != NULL) {
+      int present = PySequence_Contains(other_probe, key);
+      if (present < 0) {
+        Py_DECREF(key);
+        Py_DECREF(iter);
+        goto fail;
+      }
+      /* Elements keep their shard index because the result table has the
+       * same size as this one.
+       */
+      int rc = present ? PySet_Add(result_table->buckets[i], key) : 0;
+      Py_DECREF(key);
+      if (rc < 0) {
+        Py_DECREF(iter);
+        goto fail;
+      }
+    }
+    Py_DECREF(iter);
+    if (PyErr_Occurred()) {
+      goto fail;
+    }
+  }
+  Py_XDECREF(other_owned);
+  return (PyObject*)result;
+
+fail:
+  Py_XDECREF(other_owned);
+  Py_DECREF(result);
+  return NULL;
+}
+
+/* Create a plain set from the elements in this ConcurrentSet. Not thread
+ * consistent.
+ */
+static PyObject* ConcurrentSet_as_set(
+    ConcurrentSetObject* self,
+    PyObject* Py_UNUSED(args)) {
+  if (ConcurrentSet_finish_grow(self) < 0) {
+    return NULL;
+  }
+  PyObject* set = PySet_New(NULL);
+  if (set == NULL) {
+    return NULL;
+  }
+  ConcurrentSetTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PyObject* merged = PyNumber_InPlaceOr(set, table->buckets[i]);
+      if (merged == NULL) {
+        Py_DECREF(set);
+        return NULL;
+      }
+      Py_DECREF(merged);
+    }
+  }
+  return set;
+}
+
+/* Remove all elements without deallocating buckets. */
+static PyObject* ConcurrentSet_clearmethod(
+    ConcurrentSetObject* self,
+    PyObject* Py_UNUSED(args)) {
+  if (ConcurrentSet_finish_grow(self) < 0) {
+    return NULL;
+  }
+  ConcurrentSetTable* table = self->table;
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      PySet_Clear(table->buckets[i]);
+    }
+  }
+  Py_RETURN_NONE;
+}
+
+/* ---- Iterator ---- */
+
+/* Iterates shard-by-shard over a private copy of one shard at a time, like
+ * ConcurrentDict's snapshot iterator; extra memory is bounded by the
+ * largest shard. Not thread consistent across shards.
+ */
+typedef struct {
+  PyObject_HEAD ConcurrentSetObject* set;
+  PyObject* snapshot_iter; /* iterator over a copy of the current shard */
+  Py_ssize_t bucket_index; /* next shard to snapshot */
+  PyObject* weakreflist;
+} ConcurrentSetIteratorObject;
+
+static int ConcurrentSetIterator_clear(ConcurrentSetIteratorObject* self) {
+  Py_CLEAR(self->set);
+  Py_CLEAR(self->snapshot_iter);
+  return 0;
+}
+
+static int ConcurrentSetIterator_traverse(
+    ConcurrentSetIteratorObject* self,
+    visitproc visit,
+    void* arg) {
+  Py_VISIT(self->set);
+  Py_VISIT(self->snapshot_iter);
+  return 0;
+}
+
+static void ConcurrentSetIterator_dealloc(ConcurrentSetIteratorObject* self) {
+  PyObject_GC_UnTrack(self);
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  (void)ConcurrentSetIterator_clear(self);
+  PyObject_GC_Del(self);
+}
+
+static PyObject* ConcurrentSetIterator_next(ConcurrentSetIteratorObject* self) {
+  ConcurrentSetObject* set = self->set;
+  if (set == NULL) {
+    return NULL;
+  }
+  for (;;) {
+    if (self->snapshot_iter != NULL) {
+      PyObject* key = PyIter_Next(self->snapshot_iter);
+      if (key != NULL || PyErr_Occurred()) {
+        return key;
+      }
+      Py_CLEAR(self->snapshot_iter);
+    }
+    ConcurrentSetTable* table = _Py_atomic_load_ptr(&set->table);
+    if (self->bucket_index >= table->size) {
+      return NULL;
+    }
+    PyObject* bucket = table->buckets[self->bucket_index];
+    self->bucket_index++;
+    if (bucket == NULL) {
+      continue;
+    }
+    PyObject* copy = PySet_New(bucket);
+    if (copy == NULL) {
+      return NULL;
+    }
+    self->snapshot_iter = PyObject_GetIter(copy);
+    Py_DECREF(copy);
+    if (self->snapshot_iter == NULL) {
+      return NULL;
+    }
+  }
+}
+
+PyTypeObject ConcurrentSetIteratorType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name =
+        "_concurrency.ConcurrentSetIterator",
+    .tp_doc = "ConcurrentSetIterator",
+    .tp_basicsize = sizeof(ConcurrentSetIteratorObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_weaklistoffset = offsetof(ConcurrentSetIteratorObject, weakreflist),
+
+    .tp_clear = (inquiry)ConcurrentSetIterator_clear,
+    .tp_traverse = (traverseproc)ConcurrentSetIterator_traverse,
+    .tp_dealloc = (destructor)ConcurrentSetIterator_dealloc,
+
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)ConcurrentSetIterator_next,
+};
+
+static PyObject* ConcurrentSet_iter(ConcurrentSetObject* self) {
+  if (ConcurrentSet_finish_grow(self) < 0) {
+    return NULL;
+  }
+  ConcurrentSetIteratorObject* iterator =
+      PyObject_GC_New(ConcurrentSetIteratorObject, &ConcurrentSetIteratorType);
+  if (iterator == NULL) {
+    return NULL;
+  }
+
+  iterator->set = (ConcurrentSetObject*)Py_NewRef(self);
+  iterator->snapshot_iter = NULL;
+  iterator->bucket_index = 0;
+  iterator->weakreflist = NULL;
+
+  PyObject_GC_Track(iterator);
+  return (PyObject*)iterator;
+}
+
+/* ---- GC / infrastructure ---- */
+
+/* Two ConcurrentSets (or a ConcurrentSet and a plain set) are equal if they
+ * hold the same elements. Not thread consistent.
+ */
+static PyObject*
+ConcurrentSet_richcompare(PyObject* self_obj, PyObject* other_obj, int op) {
+  if (op != Py_EQ && op != Py_NE) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+
+  PyObject* self_set = NULL;
+  PyObject* other_set = NULL;
+
+  if (Py_TYPE(self_obj) == Py_TYPE(other_obj)) {
+    self_set = ConcurrentSet_as_set((ConcurrentSetObject*)self_obj, NULL);
+    if (self_set == NULL) {
+      return NULL;
+    }
+    other_set = ConcurrentSet_as_set((ConcurrentSetObject*)other_obj, NULL);
+    if (other_set == NULL) {
+      Py_DECREF(self_set);
+      return NULL;
+    }
+  } else if (PyAnySet_Check(other_obj)) {
+    self_set = ConcurrentSet_as_set((ConcurrentSetObject*)self_obj, NULL);
+    if (self_set == NULL) {
+      return NULL;
+    }
+    other_set = Py_NewRef(other_obj);
+  } else {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+
+  int result = PyObject_RichCompareBool(self_set, other_set, Py_EQ);
+  Py_DECREF(self_set);
+  Py_DECREF(other_set);
+
+  if (result < 0) {
+    return NULL;
+  }
+  if (op == Py_NE) {
+    result = !result;
+  }
+  if (result) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+}
+
+/* Return a string representation: ConcurrentSet({...}). Not thread
+ * consistent. */
+static PyObject* ConcurrentSet_repr(ConcurrentSetObject* self) {
+  PyObject* set = ConcurrentSet_as_set(self, NULL);
+  if (set == NULL) {
+    return NULL;
+  }
+  PyObject* set_repr = PyObject_Repr(set);
+  Py_DECREF(set);
+  if (set_repr == NULL) {
+    return NULL;
+  }
+  PyObject* result = PyUnicode_FromFormat("ConcurrentSet(%U)", set_repr);
+  Py_DECREF(set_repr);
+  return result;
+}
+
+static int ConcurrentSet_traverse(
+    ConcurrentSetObject* self,
+    visitproc visit,
+    void* arg) {
+  /* May not call back into Python here so both tables are walked directly
+   * rather than finishing any in-progress grow. */
+  Py_ssize_t i;
+  if (self->table != NULL) {
+    for (i = 0; i < self->table->size; i++) {
+      Py_VISIT(self->table->buckets[i]);
+    }
+  }
+  if (self->old_table != NULL) {
+    for (i = 0; i < self->old_table->size; i++) {
+      Py_VISIT(self->old_table->buckets[i]);
+    }
+  }
+  /* Retired buckets are normally empty, but a writer racing a grow can
+   * repopulate one briefly before its retry scrubs it. */
+  for (ConcurrentSetTable* t = self->retired; t != NULL; t = t->next_retired) {
+    for (i = 0; i < t->size; i++) {
+      Py_VISIT(t->buckets[i]);
+    }
+  }
+  return 0;
+}
+
+static Py_ssize_t ConcurrentSet_len(ConcurrentSetObject* self) {
+  Py_ssize_t total = 0;
+  ConcurrentSetTable* table = _Py_atomic_load_ptr(&self->table);
+  for (Py_ssize_t i = 0; i < table->size; i++) {
+    if (table->buckets[i]) {
+      total += PySet_Size(table->buckets[i]);
+    }
+  }
+  ConcurrentSetTable* old_table = _Py_atomic_load_ptr(&self->old_table);
+  if (old_table != NULL) {
+    /* Elements drain out of old buckets as they migrate so they are only
+     * counted once. The table stays allocated after it drains (see the
+     * retired list) so this unlocked walk never touches freed memory. */
+    for (Py_ssize_t i = 0; i < old_table->size; i++) {
+      if (old_table->buckets[i]) {
+        total += PySet_Size(old_table->buckets[i]);
+      }
+    }
+  }
+  return total;
+}
+
+static PySequenceMethods ConcurrentSet_sequence = {
+    .sq_length = (lenfunc)ConcurrentSet_len,
+    .sq_contains = (objobjproc)ConcurrentSet_contains,
+};
+
+static PyMethodDef ConcurrentSet_methods[] = {
+    {"add",
+     (PyCFunction)ConcurrentSet_add,
+     METH_O,
+     PyDoc_STR("S.add(element) -> None. Add an element to the set.")},
+    {"discard",
+     (PyCFunction)ConcurrentSet_discard,
+     METH_O,
+     PyDoc_STR(
+         "S.discard(element) -> None. Remove an element if present; no error if missing.")},
+    {"remove",
+     (PyCFunction)ConcurrentSet_remove,
+     METH_O,
+     PyDoc_STR(
+         "S.remove(element) -> None. Remove an element, raising KeyError if missing.")},
+    {"update",
+     (PyCFunction)ConcurrentSet_update,
+     METH_O,
+     PyDoc_STR(
+         "S.update(iterable) -> None. Add all elements in one C-level pass; another ConcurrentSet with the same shard count merges shard-by-shard. Not thread consistent across the batch.")},
+    {"union",
+     (PyCFunction)ConcurrentSet_union,
+     METH_O,
+     PyDoc_STR(
+         "S.union(iterable) -> ConcurrentSet. Return a new set with elements from both sides, merging shard-by-shard where possible. Not thread consistent.")},
+    {"intersection",
+     (PyCFunction)ConcurrentSet_intersection,
+     METH_O,
+     PyDoc_STR(
+         "S.intersection(iterable) -> ConcurrentSet. Return a new set with the elements common to both sides, intersecting shard-by-shard. Not thread consistent.")},
+    {"as_set",
+     (PyCFunction)ConcurrentSet_as_set,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Create a set from the elements in this ConcurrentSet. Not thread consistent.")},
+    {"clear",
+     (PyCFunction)ConcurrentSet_clearmethod,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Remove all elements from the ConcurrentSet. Not thread consistent.")},
+    {NULL, NULL, 0, NULL}};
+
+PyTypeObject ConcurrentSetType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "_concurrency.ConcurrentSet",
+    .tp_doc = "Concurrent Set",
+    .tp_basicsize = sizeof(ConcurrentSetObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_as_sequence = &ConcurrentSet_sequence,
+    .tp_methods = ConcurrentSet_methods,
+    .tp_new = ConcurrentSet_new,
+    .tp_dealloc = (destructor)ConcurrentSet_dealloc,
+    .tp_traverse = (traverseproc)ConcurrentSet_traverse,
+    .tp_clear = (inquiry)ConcurrentSet_clear,
+    .tp_weaklistoffset = offsetof(ConcurrentSetObject, weakreflist),
+    .tp_richcompare = ConcurrentSet_richcompare,
+    .tp_repr = (reprfunc)ConcurrentSet_repr,
+    .tp_iter = (getiterfunc)ConcurrentSet_iter,
+};
@@ -0,0 +1,11 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef CONCURRENT_SET_H
+#define CONCURRENT_SET_H
+
+#include <Python.h>
+
+extern PyTypeObject ConcurrentSetType;
+extern PyTypeObject ConcurrentSetIteratorType;
+
+#endif /* CONCURRENT_SET_H */
@@ -0,0 +1,745 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#include "ft_utils.h"
+
+#include "shared_dict.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* A read-mostly dictionary whose storage lives in a named shared-memory
+ * segment, so many processes can serve the same data from one copy and a
+ * restarted process starts with a map rather than a rebuild.
+ *
+ * The segment holds a header, an open-addressed slot table and an
+ * append-only data region:
+ *
+ *   [ header | slots[capacity] | data region ]
+ *
+ * Each slot stores the key hash and the offsets of the key and value
+ * entries in the data region (offset 0 means empty / deleted). Entries are
+ * a tag-plus-size word followed by the payload, so keys and values are
+ * restricted to flat types: bytes, str, int (64 bit) and, for values,
+ * float. Hashes are FNV-1a over the serialized key, not PyObject_Hash,
+ * because per-process hash randomization would make the table unreadable
+ * from another process.
+ *
+ * One process builds (create=True) and publishes; readers mmap-and-go.
+ * Readers are lock free: a writer appends the value payload before
+ * publishing its offset with release ordering, and publishes the key
+ * offset last when inserting, so a reader that sees a slot sees complete
+ * data. Concurrent writers are not supported — writes come from the single
+ * owning process, matching the immutable/read-mostly use case.
+ */
+
+#define SHARED_DICT_MAGIC 0x3143494448535446ull /* "FTSHDIC1" */
+
+/* Entry tags for serialized keys and values. */
+#define SHARED_DICT_TAG_BYTES 1
+#define SHARED_DICT_TAG_STR 2
+#define SHARED_DICT_TAG_INT 3
+#define SHARED_DICT_TAG_FLOAT 4
+
+typedef struct {
+  uint64_t magic;
+  uint64_t capacity; /* slot count, power of two */
+  uint64_t count; /* live entries */
+  uint64_t data_size; /* bytes in the data region */
+  uint64_t data_used; /* bump pointer; offset 0 is reserved */
+  uint64_t ready; /* set once the creating process finished init */
+} SharedDictHeader;
+
+typedef struct {
+  uint64_t hash;
+  uint64_t key_offset; /* 0 = slot empty */
+  uint64_t value_offset; /* 0 = deleted */
+} SharedDictSlot;
+
+typedef struct {
+  PyObject_HEAD char* name; /* name as given by the caller */
+  void* base; /* NULL once closed */
+  size_t map_size;
+  int writable;
+#if defined(_WIN32) || defined(_WIN64)
+  HANDLE map_handle;
+#endif
+  PyObject* weakreflist;
+} SharedMemoryDictObject;
+
+static inline SharedDictHeader* SharedDict_header(SharedMemoryDictObject* self) {
+  return (SharedDictHeader*)self->base;
+}
+
+static inline SharedDictSlot* SharedDict_slots(SharedMemoryDictObject* self) {
+  return (SharedDictSlot*)((char*)self->base + sizeof(SharedDictHeader));
+}
+
+static inline char* SharedDict_data(SharedMemoryDictObject* self) {
+  return (char*)self->base + sizeof(SharedDictHeader) +
+      SharedDict_header(self)->capacity * sizeof(SharedDictSlot);
+}
+
+/* A key or value serialized to its in-segment form. Fixed width payloads
+ * live in scratch; bytes/str payloads point into the source object.
+ */
+typedef struct {
+  uint8_t tag;
+  const char* data;
+  Py_ssize_t size;
+  char scratch[8];
+} SharedDictEncoded;
+
+static int
+SharedDict_encode(PyObject* obj, int for_key, SharedDictEncoded* out) {
+  if (PyBytes_CheckExact(obj)) {
+    out->tag = SHARED_DICT_TAG_BYTES;
+    out->data = PyBytes_AS_STRING(obj);
+    out->size = PyBytes_GET_SIZE(obj);
+    return 0;
+  }
+  if (PyUnicode_CheckExact(obj)) {
+    out->tag = SHARED_DICT_TAG_STR;
+    out->data = PyUnicode_AsUTF8AndSize(obj, &out->size);
+    return out->data == NULL ? -1 : 0;
+  }
+  if (PyLong_CheckExact(obj)) {
+    int64_t value = PyLong_AsLongLong(obj);
+    if (value == -1 && PyErr_Occurred()) {
+      return -1;
+    }
+    out->tag = SHARED_DICT_TAG_INT;
+    memcpy(out->scratch, &value, sizeof(value));
+    out->data = out->scratch;
+    out->size = sizeof(value);
+    return 0;
+  }
+  if (!for_key && PyFloat_CheckExact(obj)) {
+    double value = PyFloat_AS_DOUBLE(obj);
+    out->tag = SHARED_DICT_TAG_FLOAT;
+    memcpy(out->scratch, &value, sizeof(value));
+    out->data = out->scratch;
+    out->size = sizeof(value);
+    return 0;
+  }
+  PyErr_Format(
+      PyExc_TypeError,
+      "SharedMemoryDict %s must be bytes, str or int%s, not %.100s",
+      for_key ? "keys" : "values",
+      for_key ? "" : " or float",
+      Py_TYPE(obj)->tp_name);
+  return -1;
+}
+
+/* Decode the entry at a data-region offset back into a Python object. */
+static PyObject* SharedDict_decode(SharedMemoryDictObject* self, uint64_t offset) {
+  char* entry = SharedDict_data(self) + offset;
+  uint64_t meta;
+  memcpy(&meta, entry, sizeof(meta));
+  uint8_t tag = (uint8_t)(meta & 0xff);
+  Py_ssize_t size = (Py_ssize_t)(meta >> 8);
+  char* payload = entry + sizeof(meta);
+  switch (tag) {
+    case SHARED_DICT_TAG_BYTES:
+      return PyBytes_FromStringAndSize(payload, size);
+    case SHARED_DICT_TAG_STR:
+      return PyUnicode_DecodeUTF8(payload, size, NULL);
+    case SHARED_DICT_TAG_INT: {
+      int64_t value;
+      memcpy(&value, payload, sizeof(value));
+      return PyLong_FromLongLong(value);
+    }
+    case SHARED_DICT_TAG_FLOAT: {
+      double value;
+      memcpy(&value, payload, sizeof(value));
+      return PyFloat_FromDouble(value);
+    }
+    default:
+      PyErr_SetString(
+          PyExc_RuntimeError, "Corrupt SharedMemoryDict entry tag.");
+      return NULL;
+  }
+}
+
+/* Process-stable FNV-1a over the tag and serialized payload. */
+static uint64_t SharedDict_hash(const SharedDictEncoded* encoded) {
+  uint64_t hash = 1469598103934665603ull;
+  hash ^= encoded->tag;
+  hash *= 1099511628211ull;
+  for (Py_ssize_t i = 0; i < encoded->size; i++) {
+    hash ^= (uint8_t)encoded->data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static int SharedDict_entry_matches(
+    SharedMemoryDictObject* self,
+    uint64_t offset,
+    const SharedDictEncoded* encoded) {
+  char* entry = SharedDict_data(self) + offset;
+  uint64_t meta;
+  memcpy(&meta, entry, sizeof(meta));
+  if ((uint8_t)(meta & 0xff) != encoded->tag ||
+      (Py_ssize_t)(meta >> 8) != encoded->size) {
+    return 0;
+  }
+  return memcmp(entry + sizeof(meta), encoded->data, encoded->size) == 0;
+}
+
+/* Append an encoded entry to the data region and return its offset, or 0
+ * if the region is exhausted. Single writer; offsets are published by the
+ * caller with release ordering.
+ */
+static uint64_t SharedDict_append(
+    SharedMemoryDictObject* self,
+    const SharedDictEncoded* encoded) {
+  SharedDictHeader* header = SharedDict_header(self);
+  uint64_t needed = sizeof(uint64_t) + (uint64_t)encoded->size;
+  /* Keep entries 8-byte aligned so the meta word can be read whole. */
+  needed = (needed + 7) & ~7ull;
+  uint64_t offset = header->data_used;
+  if (offset + needed > header->data_size) {
+    PyErr_SetString(
+        PyExc_RuntimeError, "SharedMemoryDict data region is full.");
+    return 0;
+  }
+  char* entry = SharedDict_data(self) + offset;
+  uint64_t meta = ((uint64_t)encoded->size << 8) | encoded->tag;
+  memcpy(entry, &meta, sizeof(meta));
+  memcpy(entry + sizeof(meta), encoded->data, encoded->size);
+  header->data_used = offset + needed;
+  return offset;
+}
+
+/* Find the slot for an encoded key. Returns the matching slot, or, when
+ * want_empty is set, the first insertable slot; NULL when absent or full.
+ */
+static SharedDictSlot* SharedDict_probe(
+    SharedMemoryDictObject* self,
+    const SharedDictEncoded* encoded,
+    uint64_t hash,
+    int want_empty) {
+  SharedDictHeader* header = SharedDict_header(self);
+  SharedDictSlot* slots = SharedDict_slots(self);
+  uint64_t mask = header->capacity - 1;
+  uint64_t index = hash & mask;
+  for (uint64_t step = 0; step < header->capacity; step++) {
+    SharedDictSlot* slot = &slots[index];
+    uint64_t key_offset = _Py_atomic_load_uint64_acquire(&slot->key_offset);
+    if (key_offset == 0) {
+      return want_empty ? slot : NULL;
+    }
+    if (slot->hash == hash &&
+        SharedDict_entry_matches(self, key_offset, encoded)) {
+      return slot;
+    }
+    index = (index + 1) & mask;
+  }
+  if (want_empty) {
+    PyErr_SetString(PyExc_RuntimeError, "SharedMemoryDict is full.");
+  }
+  return NULL;
+}
+
+static int SharedDict_check_open(SharedMemoryDictObject* self) {
+  if (self->base == NULL) {
+    PyErr_SetString(
+        PyExc_RuntimeError, "SharedMemoryDict has been closed.");
+    return -1;
+  }
+  return 0;
+}
+
+/* ---- Mapping protocol ---- */
+
+static PyObject* SharedDict_lookup(
+    SharedMemoryDictObject* self,
+    PyObject* key,
+    int* found) {
+  *found = 0;
+  if (SharedDict_check_open(self) < 0) {
+    return NULL;
+  }
+  SharedDictEncoded encoded;
+  if (SharedDict_encode(key, 1, &encoded) < 0) {
+    return NULL;
+  }
+  SharedDictSlot* slot =
+      SharedDict_probe(self, &encoded, SharedDict_hash(&encoded), 0);
+  if (slot == NULL) {
+    return NULL;
+  }
+  uint64_t value_offset = _Py_atomic_load_uint64_acquire(&slot->value_offset);
+  if (value_offset == 0) {
+    return NULL;
+  }
+  *found = 1;
+  return SharedDict_decode(self, value_offset);
+}
+
+static PyObject* SharedDict_getitem(
+    SharedMemoryDictObject* self,
+    PyObject* key) {
+  int found;
+  PyObject* value = SharedDict_lookup(self, key, &found);
+  if (value == NULL && !PyErr_Occurred()) {
+    PyErr_SetObject(PyExc_KeyError, key);
+  }
+  return value;
+}
+
+static int SharedDict_setitem(
+    SharedMemoryDictObject* self,
+    PyObject* key,
+    PyObject* value) {
+  if (SharedDict_check_open(self) < 0) {
+    return -1;
+  }
+  if (!self->writable) {
+    PyErr_SetString(
+        PyExc_RuntimeError, "SharedMemoryDict was opened read-only.");
+    return -1;
+  }
+  SharedDictEncoded encoded_key;
+  if (SharedDict_encode(key, 1, &encoded_key) < 0) {
+    return -1;
+  }
+  uint64_t hash = SharedDict_hash(&encoded_key);
+  SharedDictHeader* header = SharedDict_header(self);
+  SharedDictSlot* slot = SharedDict_probe(self, &encoded_key, hash, value != NULL);
+  if (value == NULL) {
+    /* Deletion: publish the value as gone but keep the key so probe
+     * chains through this slot stay intact.
+     */
+    if (slot == NULL ||
+        _Py_atomic_load_uint64_acquire(&slot->value_offset) == 0) {
+      PyErr_SetObject(PyExc_KeyError, key);
+      return -1;
+    }
+    _Py_atomic_store_uint64_release(&slot->value_offset, 0);
+    header->count--;
+    return 0;
+  }
+  if (slot == NULL) {
+    return -1;
+  }
+
+  SharedDictEncoded encoded_value;
+  if (SharedDict_encode(value, 0, &encoded_value) < 0) {
+    return -1;
+  }
+  uint64_t value_offset = SharedDict_append(self, &encoded_value);
+  if (value_offset == 0) {
+    return -1;
+  }
+  if (slot->key_offset == 0) {
+    uint64_t key_offset = SharedDict_append(self, &encoded_key);
+    if (key_offset == 0) {
+      return -1;
+    }
+    slot->hash = hash;
+    slot->value_offset = value_offset;
+    /* Publishing the key offset last makes the whole slot visible. */
+    _Py_atomic_store_uint64_release(&slot->key_offset, key_offset);
+    header->count++;
+  } else {
+    if (_Py_atomic_load_uint64_acquire(&slot->value_offset) == 0) {
+      header->count++; /* resurrecting a deleted key */
+    }
+    _Py_atomic_store_uint64_release(&slot->value_offset, value_offset);
+  }
+  return 0;
+}
+
+static int SharedDict_contains(SharedMemoryDictObject* self, PyObject* key) {
+  int found;
+  PyObject* value = SharedDict_lookup(self, key, &found);
+  if (value == NULL) {
+    return PyErr_Occurred() ? -1 : 0;
+  }
+  Py_DECREF(value);
+  return found;
+}
+
+static Py_ssize_t SharedDict_len(SharedMemoryDictObject* self) {
+  if (SharedDict_check_open(self) < 0) {
+    return -1;
+  }
+  return (Py_ssize_t)_Py_atomic_load_uint64(&SharedDict_header(self)->count);
+}
+
+static PyObject* SharedDict_get(SharedMemoryDictObject* self, PyObject* args) {
+  PyObject* key;
+  PyObject* default_value = Py_None;
+  if (!PyArg_ParseTuple(args, "O|O", &key, &default_value)) {
+    return NULL;
+  }
+  int found;
+  PyObject* value = SharedDict_lookup(self, key, &found);
+  if (value == NULL && !PyErr_Occurred()) {
+    return Py_NewRef(default_value);
+  }
+  return value;
+}
+
+/* Return a list of all keys. Not thread consistent. */
+static PyObject* SharedDict_keys(
+    SharedMemoryDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+  if (SharedDict_check_open(self) < 0) {
+    return NULL;
+  }
+  PyObject* list = PyList_New(0);
+  if (list == NULL) {
+    return NULL;
+  }
+  SharedDictHeader* header = SharedDict_header(self);
+  SharedDictSlot* slots = SharedDict_slots(self);
+  for (uint64_t i = 0; i < header->capacity; i++) {
+    uint64_t key_offset = _Py_atomic_load_uint64_acquire(&slots[i].key_offset);
+    if (key_offset == 0 ||
+        _Py_atomic_load_uint64_acquire(&slots[i].value_offset) == 0) {
+      continue;
+    }
+    PyObject* key = SharedDict_decode(self, key_offset);
+    if (key == NULL || PyList_Append(list, key) < 0) {
+      Py_XDECREF(key);
+      Py_DECREF(list);
+      return NULL;
+    }
+    Py_DECREF(key);
+  }
+  return list;
+}
+
+/* Create a dict from the entries in this SharedMemoryDict. Not thread
+ * consistent. */
+static PyObject* SharedDict_as_dict(
+    SharedMemoryDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+  if (SharedDict_check_open(self) < 0) {
+    return NULL;
+  }
+  PyObject* dict = PyDict_New();
+  if (dict == NULL) {
+    return NULL;
+  }
+  SharedDictHeader* header = SharedDict_header(self);
+  SharedDictSlot* slots = SharedDict_slots(self);
+  for (uint64_t i = 0; i < header->capacity; i++) {
+    uint64_t key_offset = _Py_atomic_load_uint64_acquire(&slots[i].key_offset);
+    uint64_t value_offset =
+        _Py_atomic_load_uint64_acquire(&slots[i].value_offset);
+    if (key_offset == 0 || value_offset == 0) {
+      continue;
+    }
+    PyObject* key = SharedDict_decode(self, key_offset);
+    PyObject* value = key ? SharedDict_decode(self, value_offset) : NULL;
+    if (value == NULL || PyDict_SetItem(dict, key, value) < 0) {
+      Py_XDECREF(key);
+      Py_XDECREF(value);
+      Py_DECREF(dict);
+      return NULL;
+    }
+    Py_DECREF(key);
+    Py_DECREF(value);
+  }
+  return dict;
+}
+
+/* ---- Mapping lifecycle ---- */
+
+static void SharedDict_unmap(SharedMemoryDictObject* self) {
+  if (self->base != NULL) {
+#if defined(_WIN32) || defined(_WIN64)
+    UnmapViewOfFile(self->base);
+    CloseHandle(self->map_handle);
+#else
+    munmap(self->base, self->map_size);
+#endif
+    self->base = NULL;
+  }
+}
+
+/* Unmap the segment; the segment itself lives on for other processes. */
+static PyObject* SharedDict_close(
+    SharedMemoryDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+  SharedDict_unmap(self);
+  Py_RETURN_NONE;
+}
+
+/* Remove the named segment from the system. Existing mappings stay valid
+ * until their owners close. No-op on Windows where the segment is
+ * reference counted away with its last handle.
+ */
+static PyObject* SharedDict_unlink(
+    SharedMemoryDictObject* self,
+    PyObject* Py_UNUSED(args)) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  char shm_name[256];
+  snprintf(
+      shm_name,
+      sizeof(shm_name),
+      "%s%s",
+      self->name[0] == '/' ? "" : "/",
+      self->name);
+  if (shm_unlink(shm_name) != 0 && errno != ENOENT) {
+    PyErr_SetFromErrno(PyExc_OSError);
+    return NULL;
+  }
+#endif
+  Py_RETURN_NONE;
+}
+
+static void SharedDict_dealloc(SharedMemoryDictObject* self) {
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  SharedDict_unmap(self);
+  PyMem_Free(self->name);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject*
+SharedDict_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  const char* name = NULL;
+  int create = 0;
+  Py_ssize_t capacity = 0;
+  Py_ssize_t data_size = 0;
+  int writable = -1;
+  static char* kwlist[] = {
+      "name", "create", "capacity", "data_size", "writable", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args,
+          kwds,
+          "s|pnnp",
+          kwlist,
+          &name,
+          &create,
+          &capacity,
+          &data_size,
+          &writable)) {
+    return NULL;
+  }
+  if (writable == -1) {
+    writable = create; /* creators write; attachers default to read-only */
+  }
+  if (create && !writable) {
+    PyErr_SetString(
+        PyExc_ValueError, "A created SharedMemoryDict must be writable.");
+    return NULL;
+  }
+
+  SharedMemoryDictObject* self =
+      (SharedMemoryDictObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->base = NULL;
+  self->writable = writable;
+  self->weakreflist = NULL;
+  self->name = PyMem_Malloc(strlen(name) + 1);
+  if (self->name == NULL) {
+    Py_DECREF(self);
+    return PyErr_NoMemory();
+  }
+  strcpy(self->name, name);
+
+  uint64_t slots = 0;
+  uint64_t data_bytes = 0;
+  if (create) {
+    if (capacity <= 0) {
+      capacity = 1024;
+    }
+    if (data_size <= 0) {
+      data_size = 1 << 20;
+    }
+    /* Power-of-two slot count at no more than 50% load. */
+    slots = 8;
+    while (slots < (uint64_t)capacity * 2) {
+      slots <<= 1;
+    }
+    data_bytes = (uint64_t)data_size;
+    self->map_size = sizeof(SharedDictHeader) +
+        slots * sizeof(SharedDictSlot) + data_bytes;
+  }
+
+#if defined(_WIN32) || defined(_WIN64)
+  if (create) {
+    self->map_handle = CreateFileMappingA(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_READWRITE,
+        (DWORD)(self->map_size >> 32),
+        (DWORD)(self->map_size & 0xffffffff),
+        name);
+    if (self->map_handle == NULL || GetLastError() == ERROR_ALREADY_EXISTS) {
+      if (self->map_handle != NULL) {
+        CloseHandle(self->map_handle);
+      }
+      PyErr_Format(
+          PyExc_FileExistsError, "Shared memory '%s' already exists.", name);
+      Py_DECREF(self);
+      return NULL;
+    }
+  } else {
+    self->map_handle = OpenFileMappingA(
+        writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, FALSE, name);
+    if (self->map_handle == NULL) {
+      PyErr_Format(
+          PyExc_FileNotFoundError, "Shared memory '%s' not found.", name);
+      Py_DECREF(self);
+      return NULL;
+    }
+  }
+  self->base = MapViewOfFile(
+      self->map_handle,
+      writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,
+      0,
+      0,
+      0);
+  if (self->base == NULL) {
+    CloseHandle(self->map_handle);
+    PyErr_SetFromWindowsErr(0);
+    Py_DECREF(self);
+    return NULL;
+  }
+#else
+  char shm_name[256];
+  snprintf(shm_name, sizeof(shm_name), "%s%s", name[0] == '/' ? "" : "/", name);
+  int fd;
+  if (create) {
+    fd = shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd >= 0 && ftruncate(fd, (off_t)self->map_size) != 0) {
+      close(fd);
+      shm_unlink(shm_name);
+      fd = -1;
+    }
+  } else {
+    fd = shm_open(shm_name, writable ? O_RDWR : O_RDONLY, 0);
+    if (fd >= 0) {
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        fd = -1;
+      } else {
+        self->map_size = (size_t)st.st_size;
+      }
+    }
+  }
+  if (fd < 0) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, name);
+    Py_DECREF(self);
+    return NULL;
+  }
+  self->base = mmap(
+      NULL,
+      self->map_size,
+      writable ? PROT_READ | PROT_WRITE : PROT_READ,
+      MAP_SHARED,
+      fd,
+      0);
+  close(fd);
+  if (self->base == MAP_FAILED) {
+    self->base = NULL;
+    if (create) {
+      shm_unlink(shm_name);
+    }
+    PyErr_SetFromErrno(PyExc_OSError);
+    Py_DECREF(self);
+    return NULL;
+  }
+#endif
+
+  SharedDictHeader* header = SharedDict_header(self);
+  if (create) {
+    memset(self->base, 0, self->map_size);
+    header->magic = SHARED_DICT_MAGIC;
+    header->capacity = slots;
+    header->count = 0;
+    header->data_size = data_bytes;
+    header->data_used = 8; /* offset 0 means empty */
+    _Py_atomic_store_uint64_release(&header->ready, 1);
+  } else {
+    if (self->map_size < sizeof(SharedDictHeader) ||
+        header->magic != SHARED_DICT_MAGIC ||
+        _Py_atomic_load_uint64_acquire(&header->ready) != 1) {
+      SharedDict_unmap(self);
+      PyErr_Format(
+          PyExc_ValueError,
+          "Shared memory '%s' is not a SharedMemoryDict segment.",
+          name);
+      Py_DECREF(self);
+      return NULL;
+    }
+  }
+  return (PyObject*)self;
+}
+
+static PyObject* SharedDict_repr(SharedMemoryDictObject* self) {
+  return PyUnicode_FromFormat(
+      "SharedMemoryDict('%s'%s)",
+      self->name,
+      self->base == NULL ? ", closed" : "");
+}
+
+static PyMappingMethods SharedDict_mapping = {
+    (lenfunc)SharedDict_len, // mp_length
+    (binaryfunc)SharedDict_getitem, // mp_subscript
+    (objobjargproc)SharedDict_setitem, // mp_ass_subscript
+};
+
+static PySequenceMethods SharedDict_sequence = {
+    .sq_contains = (objobjproc)SharedDict_contains,
+};
+
+static PyMethodDef SharedDict_methods[] = {
+    {"get",
+     (PyCFunction)SharedDict_get,
+     METH_VARARGS,
+     PyDoc_STR(
+         "D.get(key[, default]) -> value. Return value for key, or default if not present.")},
+    {"keys",
+     (PyCFunction)SharedDict_keys,
+     METH_NOARGS,
+     PyDoc_STR("Return a list of all keys. Not thread consistent.")},
+    {"as_dict",
+     (PyCFunction)SharedDict_as_dict,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Create a dict from the entries in this SharedMemoryDict. Not thread consistent.")},
+    {"close",
+     (PyCFunction)SharedDict_close,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Unmap the segment from this process; the segment itself lives on.")},
+    {"unlink",
+     (PyCFunction)SharedDict_unlink,
+     METH_NOARGS,
+     PyDoc_STR(
+         "Remove the named segment from the system; existing mappings stay valid until closed.")},
+    {NULL, NULL, 0, NULL}};
+
+PyTypeObject SharedMemoryDictType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "_concurrency.SharedMemoryDict",
+    .tp_doc =
+        "A read-mostly dictionary of flat keys and values (bytes/str/int, "
+        "float values) stored in a named shared-memory segment. One process "
+        "creates and writes; other processes attach and read lock free.",
+    .tp_basicsize = sizeof(SharedMemoryDictObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_as_mapping = &SharedDict_mapping,
+    .tp_as_sequence = &SharedDict_sequence,
+    .tp_methods = SharedDict_methods,
+    .tp_new = SharedDict_new,
+    .tp_dealloc = (destructor)SharedDict_dealloc,
+    .tp_weaklistoffset = offsetof(SharedMemoryDictObject, weakreflist),
+    .tp_repr = (reprfunc)SharedDict_repr,
+};
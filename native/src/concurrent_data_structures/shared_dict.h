@@ -0,0 +1,10 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+
+#ifndef SHARED_DICT_H
+#define SHARED_DICT_H
+
+#include <Python.h>
+
+extern PyTypeObject SharedMemoryDictType;
+
+#endif /* SHARED_DICT_H */
@@ -27,6 +27,14 @@ void ConcurrentRegisterReference(PyObject* obj) {
   _PyObject_SetMaybeWeakref(obj);
 }
 
+void ConcurrentRegisterReferenceBatch(PyObject** objs, Py_ssize_t n) {
+  for (Py_ssize_t i = 0; i < n; i++) {
+    if (objs[i] != NULL) {
+      _PyObject_SetMaybeWeakref(objs[i]);
+    }
+  }
+}
+
 PyObject* ConcurrentGetNewReference(PyObject** obj_ptr) {
   PyObject* ret = _Py_XGetRef(obj_ptr);
   if (ret == NULL) {
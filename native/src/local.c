@@ -2,6 +2,8 @@
 
 #include "ft_utils.h"
 
+#include "ft_weave.h"
+
 /* Begin LocalWrapper
    ******************
 
@@ -10,13 +12,40 @@
    being incr/decr each time we access their methods.
 */
 
+/* The number of entries in the per-wrapper attribute cache; must be a power
+   of two. The cache is direct mapped on the attribute name's hash. */
+#define LW_CACHE_SIZE 4
+
+/* One memoized attribute lookup. The entry is valid while the wrapped
+   object's type and its tp_version_tag still match; the type pointer is
+   borrowed and only ever compared for identity, never dereferenced. */
+typedef struct {
+  PyObject* name;
+  PyObject* value;
+  PyTypeObject* tp;
+  unsigned int version;
+} LWCacheEntry;
+
 typedef struct {
   PyObject_HEAD PyObject* wrapped;
   PyObject* weakreflist;
+  vectorcallfunc vectorcall;
+  LWCacheEntry cache[LW_CACHE_SIZE];
 } LocalWrapperObject;
 
 static PyTypeObject LocalWrapperType;
 
+/* Drop all memoized attribute lookups, eg because wrapped was replaced by an
+   in-place operator. */
+static void _LW_cache_clear(LocalWrapperObject* self) {
+  for (Py_ssize_t i = 0; i < LW_CACHE_SIZE; i++) {
+    Py_CLEAR(self->cache[i].name);
+    Py_CLEAR(self->cache[i].value);
+    self->cache[i].tp = NULL;
+    self->cache[i].version = 0;
+  }
+}
+
 static inline PyObject* _LW_Unwrap(PyObject* obj) {
   return PyObject_TypeCheck(obj, &LocalWrapperType)
       ? ((LocalWrapperObject*)obj)->wrapped
@@ -32,6 +61,7 @@ PyObject* _LW_Inplace_Return(LocalWrapperObject* self, PyObject* result) {
   Py_DECREF(self->wrapped);
   Py_INCREF(self);
   self->wrapped = result;
+  _LW_cache_clear(self);
   return (PyObject*)self;
 }
 
@@ -497,18 +527,64 @@ static Py_hash_t LocalWrapper_hash(LocalWrapperObject* self) {
   return PyObject_Hash(self->wrapped);
 }
 
-static PyObject*
-LocalWrapper_call(LocalWrapperObject* self, PyObject* args, PyObject* kwds) {
-  return PyObject_Call(self->wrapped, args, kwds);
+/* Calls on the wrapper forward to the wrapped object through vectorcall so a
+   hot `wrapper(...)` does not pay for argument tuple packing. */
+static PyObject* LocalWrapper_vectorcall(
+    PyObject* self,
+    PyObject* const* args,
+    size_t nargsf,
+    PyObject* kwnames) {
+  return PyObject_Vectorcall(
+      ((LocalWrapperObject*)self)->wrapped, args, nargsf, kwnames);
 }
 
 static PyObject* LocalWrapper_str(LocalWrapperObject* self) {
   return PyObject_Str(self->wrapped);
 }
 
+/* Find the cache slot for the given attribute name, or NULL when the name is
+   not hashable as a string (in which case the cache is bypassed). */
+static inline LWCacheEntry* _LW_cache_entry(
+    LocalWrapperObject* self,
+    PyObject* attr_name) {
+  if (!PyUnicode_CheckExact(attr_name)) {
+    return NULL;
+  }
+  Py_hash_t hash = ((PyASCIIObject*)attr_name)->hash;
+  if (hash == -1) {
+    hash = PyObject_Hash(attr_name);
+    if (hash == -1) {
+      PyErr_Clear();
+      return NULL;
+    }
+  }
+  return &self->cache[(size_t)hash & (LW_CACHE_SIZE - 1)];
+}
+
+/* Whether the current tp_version_tag of the given type is trustworthy. */
+static inline int _LW_version_valid(PyTypeObject* tp) {
+#ifdef Py_TPFLAGS_VALID_VERSION_TAG
+  return PyType_HasFeature(tp, Py_TPFLAGS_VALID_VERSION_TAG);
+#else
+  return tp->tp_version_tag != 0;
+#endif
+}
+
 static PyObject* LocalWrapper_getattro(
     LocalWrapperObject* self,
     PyObject* attr_name) {
+  PyTypeObject* tp = Py_TYPE(self->wrapped);
+  LWCacheEntry* entry = _LW_cache_entry(self, attr_name);
+
+  /* The fast path: we have already resolved this name against this version
+     of the wrapped object's type, so hand back the memoized value without
+     touching the MRO. Names arriving from attribute access are interned,
+     making the identity check sufficient. */
+  if (entry != NULL && entry->value != NULL && entry->name == attr_name &&
+      entry->tp == tp && entry->version == tp->tp_version_tag) {
+    return Py_NewRef(entry->value);
+  }
+
   PyObject* result = PyObject_GenericGetAttr((PyObject*)self, attr_name);
   if (result) {
     return result;
@@ -516,6 +592,21 @@ static PyObject* LocalWrapper_getattro(
   PyErr_Clear();
   result = PyObject_GenericGetAttr(self->wrapped, attr_name);
   if (result) {
+    /* Memoize the lookup when it cannot go stale silently: the name must
+       resolve to a method-like descriptor on the type (not a property or a
+       value that may vary per call), the instance must not be able to shadow
+       it with its own dict, and the type must carry a valid version tag so
+       type-level changes invalidate the entry. */
+    if (entry != NULL && tp->tp_dictoffset == 0 && _LW_version_valid(tp)) {
+      PyObject* descr = _PyType_Lookup(tp, attr_name);
+      if (descr != NULL &&
+          PyType_HasFeature(Py_TYPE(descr), Py_TPFLAGS_METHOD_DESCRIPTOR)) {
+        Py_XSETREF(entry->name, Py_NewRef(attr_name));
+        Py_XSETREF(entry->value, Py_NewRef(result));
+        entry->tp = tp;
+        entry->version = tp->tp_version_tag;
+      }
+    }
     return result;
   }
   PyErr_Clear();
@@ -556,6 +647,9 @@ static PyBufferProcs LocalWrapper_as_buffer = {
 static int
 LocalWrapper_traverse(LocalWrapperObject* self, visitproc visit, void* arg) {
   Py_VISIT(self->wrapped);
+  for (Py_ssize_t i = 0; i < LW_CACHE_SIZE; i++) {
+    Py_VISIT(self->cache[i].value);
+  }
   return 0;
 }
 
@@ -575,6 +669,7 @@ static PyObject* LocalWrapper_repr(LocalWrapperObject* self) {
 
 static int LocalWrapper_clear(LocalWrapperObject* self) {
   Py_CLEAR(self->wrapped);
+  _LW_cache_clear(self);
   return 0;
 }
 
@@ -597,6 +692,8 @@ LocalWrapper_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
     Py_INCREF(wrapped);
     self->wrapped = wrapped;
     self->weakreflist = NULL;
+    self->vectorcall = LocalWrapper_vectorcall;
+    memset(self->cache, 0, sizeof(self->cache));
   }
   return (PyObject*)self;
 }
@@ -646,7 +743,7 @@ static PyTypeObject LocalWrapperType = {
     sizeof(LocalWrapperObject), /* tp_basicsize */
     0, /* tp_itemsize */
     (destructor)LocalWrapper_dealloc, /* tp_dealloc */
-    0, /* tp_print */
+    offsetof(LocalWrapperObject, vectorcall), /* tp_vectorcall_offset */
     0,
     0,
     0, /* tp_reserved */
@@ -655,12 +752,13 @@ static PyTypeObject LocalWrapperType = {
     &LocalWrapper_as_sequence, /* tp_as_sequence */
     &LocalWrapper_as_mapping, /* tp_as_mapping */
     (hashfunc)LocalWrapper_hash, /* tp_hash */
-    (ternaryfunc)LocalWrapper_call, /* tp_call */
+    PyVectorcall_Call, /* tp_call */
     (reprfunc)LocalWrapper_str, /* tp_str */
     (getattrofunc)LocalWrapper_getattro, /* tp_getattro */
     (setattrofunc)LocalWrapper_setattro, /* tp_setattro */
     &LocalWrapper_as_buffer, /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, /* tp_flags */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+        Py_TPFLAGS_HAVE_VECTORCALL, /* tp_flags */
     "LocalWrapper objects", /* tp_doc */
     (traverseproc)LocalWrapper_traverse, /* tp_traverse */
     (inquiry)LocalWrapper_clear, /* tp_clear */
@@ -702,6 +800,140 @@ static PyObject* create_local_wrapper(PyObject* self) {
   return localWrapper;
 }
 
+/* Begin localize
+   **************
+
+   Hot functions often open by wrapping a handful of long-lived objects, each
+   wrap being a Python-level constructor call and an allocation. localize()
+   wraps many objects in one native call and serves repeat requests for the
+   same object from a small per-thread cache, so the steady state cost of the
+   preamble is a few pointer compares rather than allocations.
+
+   The cache is direct mapped on the object's address and keyed purely on
+   identity: a hit is only returned when the cached wrapper still wraps that
+   exact object, and since the wrapper keeps its wrapped object alive a
+   matching pointer cannot be a recycled address. Caches of dead threads are
+   pushed onto a lock free graveyard list by the wvls destructor (which must
+   not call into the interpreter) and their references are dropped by the
+   next localize() call on any thread. */
+
+/* The number of entries in the per-thread wrapper cache; must be a power of
+   two. A colliding entry simply evicts the old wrapper. */
+#define LW_TLS_CACHE_SIZE 16
+
+typedef struct LWTlsCache {
+  /* Only used while the cache sits on the graveyard list. */
+  struct LWTlsCache* next;
+  PyObject* wrappers[LW_TLS_CACHE_SIZE];
+} LWTlsCache;
+
+static weave_local LWTlsCache* _lw_tls_cache = NULL;
+/* Set when destructor registration is unavailable on this thread (the wvls
+   layer needs a free threaded interpreter with experimental support enabled)
+   so localize falls back to plain uncached wrapping. */
+static weave_local int _lw_tls_cache_unavailable = 0;
+static LWTlsCache* _lw_tls_graveyard = NULL;
+
+/* Runs at thread death; the cache's references can only be dropped under the
+   interpreter so the cache is parked on the graveyard instead of freed. */
+static void _lw_tls_cache_destructor(void* arg) {
+  LWTlsCache* cache = (LWTlsCache*)arg;
+  if (cache == NULL) {
+    return;
+  }
+  while (1) {
+    LWTlsCache* head = _Py_atomic_load_ptr(&_lw_tls_graveyard);
+    cache->next = head;
+    if (_Py_atomic_compare_exchange_ptr(&_lw_tls_graveyard, &head, cache)) {
+      return;
+    }
+  }
+}
+
+static void _lw_tls_drain_graveyard(void) {
+  if (_Py_atomic_load_ptr(&_lw_tls_graveyard) == NULL) {
+    return;
+  }
+  LWTlsCache* cache = _Py_atomic_exchange_ptr(&_lw_tls_graveyard, NULL);
+  while (cache != NULL) {
+    LWTlsCache* next = cache->next;
+    for (Py_ssize_t i = 0; i < LW_TLS_CACHE_SIZE; i++) {
+      Py_XDECREF(cache->wrappers[i]);
+    }
+    free(cache);
+    cache = next;
+  }
+}
+
+static PyObject* _lw_localize_one(PyObject* wrapped) {
+  if (PyObject_TypeCheck(wrapped, &LocalWrapperType)) {
+    return Py_NewRef(wrapped);
+  }
+
+  LWTlsCache* cache = _lw_tls_cache;
+  if (cache == NULL) {
+    if (_lw_tls_cache_unavailable) {
+      return create_local_wrapper(wrapped);
+    }
+    /* The cache outlives the interpreter's view of the thread so it comes
+       from plain malloc, matching what the destructor may free. */
+    cache = (LWTlsCache*)calloc(1, sizeof(LWTlsCache));
+    if (cache == NULL) {
+      PyErr_NoMemory();
+      return NULL;
+    }
+    if (_py_register_wvls_destructor(
+            (void**)&_lw_tls_cache, &_lw_tls_cache_destructor)) {
+      /* Without a destructor a cache would leak its wrappers at thread
+         death, so wrap uncached instead; localize still batches the calls. */
+      PyErr_Clear();
+      free(cache);
+      _lw_tls_cache_unavailable = 1;
+      return create_local_wrapper(wrapped);
+    }
+    _lw_tls_cache = cache;
+  }
+
+  /* The low bits of a heap address are alignment so shift them out before
+     picking the slot. */
+  size_t slot = ((uintptr_t)wrapped >> 4) & (LW_TLS_CACHE_SIZE - 1);
+  PyObject* wrapper = cache->wrappers[slot];
+  if (wrapper != NULL && ((LocalWrapperObject*)wrapper)->wrapped == wrapped) {
+    return Py_NewRef(wrapper);
+  }
+
+  wrapper = create_local_wrapper(wrapped);
+  if (wrapper == NULL) {
+    return NULL;
+  }
+  Py_XSETREF(cache->wrappers[slot], Py_NewRef(wrapper));
+  return wrapper;
+}
+
+static PyObject* local_localize(
+    PyObject* Py_UNUSED(module),
+    PyObject* const* args,
+    Py_ssize_t nargs) {
+  _lw_tls_drain_graveyard();
+  PyObject* result = PyTuple_New(nargs);
+  if (result == NULL) {
+    return NULL;
+  }
+  for (Py_ssize_t i = 0; i < nargs; i++) {
+    PyObject* wrapper = _lw_localize_one(args[i]);
+    if (wrapper == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    PyTuple_SET_ITEM(result, i, wrapper);
+  }
+  return result;
+}
+
+/* ************
+   End localize
+*/
+
 /* Begin BatchExecutor
    *******************
 
@@ -709,14 +941,35 @@ static PyObject* create_local_wrapper(PyObject* self) {
    which we can then access efficiently from multiple threads. Once the buffer
    is exhausted we fill it up again. This avoid lock contention on the execution
    and maximised memory locallity as well.
+
+   With chunk_size > 0 the executor instead hands every consumer thread its own
+   sub-buffer of chunk_size slots. A thread drains its chunk with no shared
+   state at all; when the chunk is empty it first tries to steal half of the
+   fullest other chunk and only calls the source when there is nothing worth
+   stealing, so threads no longer serialize on every refill.
 */
 
+/* A per-thread sub-buffer. Chunks live in a singly linked registry owned by
+   the executor and are only freed when the executor is cleared; a thread that
+   exits simply leaves its remaining items behind to be stolen. Slots in
+   [index, count) hold strong references; the owner and thieves claim slots
+   through the atomic index. */
+typedef struct BEChunk {
+  struct BEChunk* next;
+  THREAD_TYPE owner;
+  Py_ssize_t index;
+  Py_ssize_t count;
+  PyObject** items;
+} BEChunk;
+
 typedef struct {
   PyObject_HEAD PyObject* source;
   PyObject* weakreflist;
   Py_ssize_t size;
   Py_ssize_t index;
   PyObject** buffer;
+  Py_ssize_t chunk_size;
+  BEChunk* chunks;
 } BatchExecutorObject;
 
 static PyObject*
@@ -724,7 +977,9 @@ BatchExecutorObject_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
   BatchExecutorObject* self;
   PyObject* source = NULL;
   PyObject* py_size;
+  PyObject* py_chunk = NULL;
   Py_ssize_t size;
+  Py_ssize_t chunk_size = 0;
 
   self = (BatchExecutorObject*)type->tp_alloc(type, 0);
   if (self == NULL) {
@@ -736,8 +991,10 @@ BatchExecutorObject_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
   self->buffer = NULL;
   self->size = -1;
   self->index = 0;
+  self->chunk_size = 0;
+  self->chunks = NULL;
 
-  if (!PyArg_ParseTuple(args, "OO", &source, &py_size)) {
+  if (!PyArg_ParseTuple(args, "OO|O", &source, &py_size, &py_chunk)) {
     Py_DECREF(self);
     return NULL;
   }
@@ -766,16 +1023,38 @@ BatchExecutorObject_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
     return NULL;
   }
 
-  self->buffer = (PyObject**)PyMem_Calloc(size, sizeof(PyObject*));
-  if (!self->buffer) {
-    PyErr_NoMemory();
-    Py_DECREF(self);
-    return NULL;
+  if (py_chunk != NULL) {
+    if (!PyLong_Check(py_chunk)) {
+      PyErr_SetString(PyExc_TypeError, "chunk_size must be an integer");
+      Py_DECREF(self);
+      return NULL;
+    }
+    chunk_size = PyLong_AsSsize_t(py_chunk);
+    if (PyErr_Occurred()) {
+      Py_DECREF(self);
+      return NULL;
+    }
+    if (chunk_size < 0) {
+      PyErr_SetString(PyExc_ValueError, "chunk_size must not be negative");
+      Py_DECREF(self);
+      return NULL;
+    }
+  }
+
+  if (chunk_size == 0) {
+    /* The shared buffer is only used in the non-chunked mode. */
+    self->buffer = (PyObject**)PyMem_Calloc(size, sizeof(PyObject*));
+    if (!self->buffer) {
+      PyErr_NoMemory();
+      Py_DECREF(self);
+      return NULL;
+    }
   }
 
   Py_INCREF(source);
   self->source = source;
   self->size = size;
+  self->chunk_size = chunk_size;
   self->index =
       size; /* Critically mark this as needing filling on first call. */
 
@@ -790,12 +1069,40 @@ static void BatchExecutorObject_clear_buffer(BatchExecutorObject* self) {
   }
 }
 
+/* Drop the references still held by the per-thread chunks. The chunk structs
+   themselves stay in the registry until the object is cleared (free_chunks)
+   because another thread may still be walking it; by then only the garbage
+   collector or deallocation is running so the walk is single threaded. */
+static void BatchExecutorObject_clear_chunks(
+    BatchExecutorObject* self,
+    int free_chunks) {
+  BEChunk* chunk = self->chunks;
+  if (free_chunks) {
+    self->chunks = NULL;
+  }
+  while (chunk != NULL) {
+    BEChunk* next = chunk->next;
+    for (Py_ssize_t i = _Py_atomic_load_ssize(&(chunk->index));
+         i < chunk->count;
+         i++) {
+      Py_CLEAR(chunk->items[i]);
+    }
+    chunk->count = 0;
+    if (free_chunks) {
+      PyMem_Free(chunk->items);
+      PyMem_Free(chunk);
+    }
+    chunk = next;
+  }
+}
+
 static void BatchExecutorObject_clear_all(BatchExecutorObject* self) {
   if (self->buffer != NULL) {
     BatchExecutorObject_clear_buffer(self);
     PyMem_Free(self->buffer);
     self->buffer = NULL;
   }
+  BatchExecutorObject_clear_chunks(self, 0);
 
   Py_CLEAR(self->source);
   self->index = 0;
@@ -825,14 +1132,164 @@ static int BatchExecutorObject_fill_buffer(BatchExecutorObject* self) {
   return 0;
 }
 
+/* Find the calling thread's chunk, creating and registering one on first
+   use. The registry is a lock free prepend-only list. */
+static BEChunk* BatchExecutorObject_chunk_for_thread(BatchExecutorObject* self) {
+  THREAD_TYPE me = THREAD_ID;
+  BEChunk* chunk = _Py_atomic_load_ptr(&(self->chunks));
+  for (; chunk != NULL; chunk = chunk->next) {
+    if (THREAD_EQUAL(chunk->owner, me)) {
+      return chunk;
+    }
+  }
+
+  chunk = (BEChunk*)PyMem_Calloc(1, sizeof(BEChunk));
+  if (chunk == NULL) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  chunk->items =
+      (PyObject**)PyMem_Calloc(self->chunk_size, sizeof(PyObject*));
+  if (chunk->items == NULL) {
+    PyMem_Free(chunk);
+    PyErr_NoMemory();
+    return NULL;
+  }
+  chunk->owner = me;
+  chunk->index = 0;
+  chunk->count = 0; /* Empty, so the first load will fill or steal. */
+  while (1) {
+    BEChunk* head = _Py_atomic_load_ptr(&(self->chunks));
+    chunk->next = head;
+    if (_Py_atomic_compare_exchange_ptr(&(self->chunks), &head, chunk)) {
+      return chunk;
+    }
+  }
+}
+
+/* Move up to half of the remaining items of the fullest other chunk into
+   chunk and return how many were taken. The caller holds the critical
+   section on self so at most one thread is stealing or filling at a time;
+   the victim's owner races with us only through the atomic index, which
+   hands each slot to exactly one taker. */
+static Py_ssize_t BatchExecutorObject_steal_into(
+    BatchExecutorObject* self,
+    BEChunk* chunk) {
+  BEChunk* victim = NULL;
+  Py_ssize_t best = 1; /* Not worth stealing a single item. */
+  for (BEChunk* c = _Py_atomic_load_ptr(&(self->chunks)); c != NULL;
+       c = c->next) {
+    if (c == chunk) {
+      continue;
+    }
+    Py_ssize_t left = c->count - _Py_atomic_load_ssize(&(c->index));
+    if (left > best) {
+      best = left;
+      victim = c;
+    }
+  }
+  if (victim == NULL) {
+    return 0;
+  }
+
+  Py_ssize_t want = (best + 1) / 2;
+  Py_ssize_t stolen = 0;
+  while (stolen < want) {
+    Py_ssize_t i = _Py_atomic_add_ssize(&(victim->index), 1);
+    if (i >= victim->count) {
+      break;
+    }
+    /* The reference moves from the victim's slot to ours. */
+    chunk->items[stolen++] = victim->items[i];
+  }
+  if (stolen > 0) {
+    chunk->count = stolen;
+    _Py_atomic_fence_release();
+    _Py_atomic_store_ssize(&(chunk->index), 0);
+  }
+  return stolen;
+}
+
+/* Refill chunk from the source; same error handling as fill_buffer. The
+   caller holds the critical section on self. */
+static int BatchExecutorObject_fill_chunk(
+    BatchExecutorObject* self,
+    BEChunk* chunk) {
+  PyObject* result;
+  for (Py_ssize_t i = 0; i < self->chunk_size; i++) {
+    result = PyObject_CallObject(self->source, NULL);
+    if (result == NULL) {
+      while (i > 0) {
+        Py_CLEAR(chunk->items[--i]);
+      }
+      BatchExecutorObject_clear_all(self);
+      _Py_atomic_fence_release();
+      return -1;
+    }
+    chunk->items[i] = result;
+  }
+  chunk->count = self->chunk_size;
+  _Py_atomic_fence_release();
+  _Py_atomic_store_ssize(&(chunk->index), 0);
+  return 0;
+}
+
+static PyObject* BatchExecutorObject_load_chunked(BatchExecutorObject* self) {
+  BEChunk* chunk;
+  Py_ssize_t index;
+  int err;
+
+  if (_Py_atomic_load_ptr(&(self->source)) == NULL) {
+    PyErr_SetString(
+        PyExc_RuntimeError,
+        "BatchExecutor is shuttdown. Was there a previous exception?");
+    return NULL;
+  }
+
+  chunk = BatchExecutorObject_chunk_for_thread(self);
+  if (chunk == NULL) {
+    return NULL;
+  }
+
+  while (1) {
+    index = _Py_atomic_add_ssize(&(chunk->index), 1);
+    if (index < _Py_atomic_load_ssize(&(chunk->count))) {
+      /* The slot's reference is handed over to the caller. */
+      return chunk->items[index];
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (self->source == NULL) {
+      PyErr_SetString(
+          PyExc_RuntimeError,
+          "BatchExecutor is shuttdown. Was there a previous exception?");
+      err = -1;
+    } else if (BatchExecutorObject_steal_into(self, chunk) > 0) {
+      err = 0;
+    } else {
+      err = BatchExecutorObject_fill_chunk(self, chunk);
+    }
+    Py_END_CRITICAL_SECTION();
+    if (err) {
+      return NULL;
+    }
+  }
+}
+
 static PyObject* BatchExecutorObject_load(BatchExecutorObject* self) {
   Py_ssize_t index;
   Py_ssize_t size = self->size;
   PyObject* ret;
-  PyObject* source = _Py_atomic_load_ptr(&(self->source));
-  PyObject* buffer = _Py_atomic_load_ptr(&(self->buffer));
+  PyObject* source;
+  PyObject* buffer;
   int err;
 
+  if (self->chunk_size > 0) {
+    return BatchExecutorObject_load_chunked(self);
+  }
+
+  source = _Py_atomic_load_ptr(&(self->source));
+  buffer = _Py_atomic_load_ptr(&(self->buffer));
+
   if (source == NULL || buffer == NULL) {
     PyErr_SetString(
         PyExc_RuntimeError,
@@ -887,6 +1344,13 @@ static int BatchExecutorObject_traverse(
       Py_VISIT(self->buffer[i]);
     }
   }
+  for (BEChunk* chunk = self->chunks; chunk != NULL; chunk = chunk->next) {
+    for (Py_ssize_t i = _Py_atomic_load_ssize(&(chunk->index));
+         i < chunk->count;
+         i++) {
+      Py_VISIT(chunk->items[i]);
+    }
+  }
   return 0;
 }
 
@@ -900,6 +1364,7 @@ static int BatchExecutorObject_clear(BatchExecutorObject* self) {
     self->buffer = NULL;
     self->size = 0;
   }
+  BatchExecutorObject_clear_chunks(self, 1);
   return 0;
 }
 
@@ -955,12 +1420,23 @@ static struct PyModuleDef_Slot module_slots[] = {
     {0, NULL} /* sentinel */
 };
 
+static PyMethodDef local_module_methods[] = {
+    {"localize",
+     (PyCFunction)local_localize,
+     METH_FASTCALL,
+     PyDoc_STR(
+         "localize(*objects) -> tuple. Wrap every argument in a LocalWrapper "
+         "in one call, reusing this thread's cached wrapper for an object "
+         "which was localized before. Arguments which are already wrappers "
+         "are passed through unchanged.")},
+    {NULL, NULL, 0, NULL}};
+
 static PyModuleDef local_module = {
     PyModuleDef_HEAD_INIT,
     "local",
     "Utilities to thread localize load and store of shared data.",
     0,
-    NULL,
+    local_module_methods,
     module_slots,
     NULL,
     NULL,
@@ -0,0 +1,222 @@
+/* Copyright (c) Meta Platforms, Inc. and affiliates. */
+#include "ft_utils.h"
+
+#include "ft_weave.h"
+
+/* A fast thread local pseudo random number generator.
+
+   random.Random serializes callers through one shared state which makes it a
+   contention hotspot on free threaded builds, and the Python level
+   workarounds in benchmark_utils still pay interpreter overhead per draw.
+   Here every thread owns a xoshiro256** generator seeded through SplitMix64,
+   held in weave local storage by value so there is nothing to allocate and
+   nothing to destruct at thread death. Draws are a few arithmetic
+   instructions with no shared state touched at all.
+
+   The generators are not cryptographically secure and, as with random.Random,
+   each thread produces its own independent stream: seeding affects only the
+   calling thread. */
+
+typedef struct {
+  uint64_t s[4];
+  int initialized;
+} rng_state_t;
+
+static weave_local rng_state_t _rng_state;
+
+/* Distinguishes the auto-seeded streams of threads which start in the same
+   nanosecond. */
+static Py_ssize_t _rng_stream_counter;
+
+static inline uint64_t _rng_splitmix64(uint64_t* x) {
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static void _rng_seed(rng_state_t* rng, uint64_t seed) {
+  /* SplitMix64 expansion is the seeding procedure recommended for xoshiro;
+     it cannot produce the all-zero state xoshiro must avoid. */
+  rng->s[0] = _rng_splitmix64(&seed);
+  rng->s[1] = _rng_splitmix64(&seed);
+  rng->s[2] = _rng_splitmix64(&seed);
+  rng->s[3] = _rng_splitmix64(&seed);
+  rng->initialized = 1;
+}
+
+static rng_state_t* _rng_get(void) {
+  rng_state_t* rng = &_rng_state;
+  if (!rng->initialized) {
+    uint64_t stream = (uint64_t)_Py_atomic_add_ssize(&_rng_stream_counter, 1);
+    _rng_seed(rng, ns_time() ^ (stream * 0xD1342543DE82EF95ULL));
+  }
+  return rng;
+}
+
+static inline uint64_t _rng_rotl(const uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+/* xoshiro256**: the next 64 uniformly random bits. */
+static inline uint64_t _rng_next(rng_state_t* rng) {
+  uint64_t* s = rng->s;
+  const uint64_t result = _rng_rotl(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = _rng_rotl(s[3], 45);
+  return result;
+}
+
+/* A uniform draw from [0, bound) for bound > 0, using rejection so small
+   bounds are not biased by the modulus. */
+static inline uint64_t _rng_below(rng_state_t* rng, uint64_t bound) {
+  uint64_t threshold = (0 - bound) % bound;
+  while (1) {
+    uint64_t raw = _rng_next(rng);
+    if (raw >= threshold) {
+      return raw % bound;
+    }
+  }
+}
+
+static PyObject* random_random(PyObject* Py_UNUSED(module)) {
+  /* The top 53 bits scaled into [0, 1), as random.random does. */
+  return PyFloat_FromDouble(
+      (double)(_rng_next(_rng_get()) >> 11) * (1.0 / 9007199254740992.0));
+}
+
+static PyObject* random_randint(
+    PyObject* Py_UNUSED(module),
+    PyObject* const* args,
+    Py_ssize_t nargs) {
+  if (nargs != 2) {
+    PyErr_SetString(PyExc_TypeError, "randint() takes exactly two arguments");
+    return NULL;
+  }
+  long long a = PyLong_AsLongLong(args[0]);
+  if (a == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  long long b = PyLong_AsLongLong(args[1]);
+  if (b == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (a > b) {
+    PyErr_SetString(PyExc_ValueError, "empty range for randint()");
+    return NULL;
+  }
+  rng_state_t* rng = _rng_get();
+  uint64_t span = (uint64_t)b - (uint64_t)a;
+  uint64_t draw =
+      span == UINT64_MAX ? _rng_next(rng) : _rng_below(rng, span + 1);
+  return PyLong_FromLongLong((long long)((uint64_t)a + draw));
+}
+
+static PyObject* random_choice(PyObject* Py_UNUSED(module), PyObject* seq) {
+  Py_ssize_t size = PySequence_Size(seq);
+  if (size < 0) {
+    return NULL;
+  }
+  if (size == 0) {
+    PyErr_SetString(
+        PyExc_IndexError, "Cannot choose from an empty sequence");
+    return NULL;
+  }
+  return PySequence_GetItem(
+      seq, (Py_ssize_t)_rng_below(_rng_get(), (uint64_t)size));
+}
+
+static PyObject* random_rand_ints(
+    PyObject* Py_UNUSED(module),
+    PyObject* const* args,
+    Py_ssize_t nargs) {
+  if (nargs != 1) {
+    PyErr_SetString(PyExc_TypeError, "rand_ints() takes exactly one argument");
+    return NULL;
+  }
+  Py_ssize_t count = PyLong_AsSsize_t(args[0]);
+  if (count == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError, "rand_ints() count must be non-negative");
+    return NULL;
+  }
+  PyObject* result = PyList_New(count);
+  if (result == NULL) {
+    return NULL;
+  }
+  rng_state_t* rng = _rng_get();
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject* value = PyLong_FromUnsignedLongLong(_rng_next(rng));
+    if (value == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, i, value);
+  }
+  return result;
+}
+
+static PyObject* random_seed(PyObject* Py_UNUSED(module), PyObject* arg) {
+  uint64_t seed = PyLong_AsUnsignedLongLongMask(arg);
+  if (seed == (uint64_t)-1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  _rng_seed(&_rng_state, seed);
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef random_module_methods[] = {
+    {"random",
+     (PyCFunction)random_random,
+     METH_NOARGS,
+     PyDoc_STR("random() -> float. A uniform float in [0, 1).")},
+    {"randint",
+     (PyCFunction)random_randint,
+     METH_FASTCALL,
+     PyDoc_STR(
+         "randint(a, b) -> int. A uniform integer in [a, b] including both "
+         "end points. The bounds must fit in a signed 64 bit integer.")},
+    {"choice",
+     (PyCFunction)random_choice,
+     METH_O,
+     PyDoc_STR("choice(seq) -> object. A uniformly chosen element of seq.")},
+    {"rand_ints",
+     (PyCFunction)random_rand_ints,
+     METH_FASTCALL,
+     PyDoc_STR(
+         "rand_ints(n) -> list. A list of n uniform integers in [0, 2**64), "
+         "drawn in one native pass.")},
+    {"seed",
+     (PyCFunction)random_seed,
+     METH_O,
+     PyDoc_STR(
+         "seed(n) -> None. Deterministically reseed the calling thread's "
+         "generator. Other threads' streams are unaffected.")},
+    {NULL, NULL, 0, NULL}};
+
+static struct PyModuleDef_Slot module_slots[] = {
+    _PY_NOGIL_MODULE_SLOT // NOLINT
+    {0, NULL} /* sentinel */
+};
+
+static PyModuleDef random_module = {
+    PyModuleDef_HEAD_INIT,
+    "random",
+    "Fast thread local pseudo random number generation.",
+    0,
+    random_module_methods,
+    module_slots,
+    NULL,
+    NULL,
+    NULL};
+
+PyMODINIT_FUNC PyInit_random(void) {
+  return PyModuleDef_Init(&random_module);
+}
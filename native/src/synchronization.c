@@ -18,6 +18,17 @@ typedef struct {
   */
   int32_t waiters;
   int32_t locked;
+  /* With adaptive set the effective cede interval floats between
+     interval / 8 and interval * 8: observed waiters shrink it so peers are
+     not starved, uncontended phases grow it back so bursts are not broken
+     up by needless handoffs. All telemetry is guarded by the mutex. */
+  int32_t adaptive;
+  ustimestamp_t current_interval;
+  uint64_t acquisitions;
+  uint64_t cedes;
+  uint64_t total_wait_us;
+  uint64_t total_hold_us;
+  uint64_t releases;
 } IntervalLock;
 
 static PyObject*
@@ -35,22 +46,57 @@ IntervalLock_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
     self->waiters = 0;
     self->owner = 0;
     self->previous_owner = 0;
+    self->adaptive = 0;
+    self->current_interval = 0;
+    self->acquisitions = 0;
+    self->cedes = 0;
+    self->total_wait_us = 0;
+    self->total_hold_us = 0;
+    self->releases = 0;
   }
   return (PyObject*)self;
 }
 
 static int
 IntervalLock_init(IntervalLock* self, PyObject* args, PyObject* kwds) {
-  static char* kwlist[] = {"interval", NULL};
+  static char* kwlist[] = {"interval", "adaptive", NULL};
   double interval = 0.005; /* Default value for the interval */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|d", kwlist, &interval)) {
+  int adaptive = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "|dp", kwlist, &interval, &adaptive)) {
     return -1;
   }
   /* Convert to microseconds. */
   self->interval = (uint64_t)(1000000 * interval);
+  self->adaptive = adaptive;
+  self->current_interval = self->interval;
   return 0;
 }
 
+/* Called with the mutex held when the lock is released or ceded. Shrink the
+   effective interval while threads are observed waiting and grow it back
+   towards the ceiling when we ran uncontended. */
+static void IntervalLock_adapt(IntervalLock* self) {
+  ustimestamp_t floor = self->interval / 8;
+  ustimestamp_t ceiling = self->interval * 8;
+  if (floor == 0) {
+    floor = 1;
+  }
+  ustimestamp_t current = self->current_interval;
+  if (self->waiters > 0) {
+    current -= current / 4;
+    if (current < floor) {
+      current = floor;
+    }
+  } else {
+    current += current / 4 + 1;
+    if (current > ceiling) {
+      current = ceiling;
+    }
+  }
+  self->current_interval = current;
+}
+
 static PyObject* IntervalLock_lock(IntervalLock* self) {
   THREAD_TYPE current_thread = THREAD_ID;
   if (self->owner != 0 && current_thread == self->owner) {
@@ -58,6 +104,7 @@ static PyObject* IntervalLock_lock(IntervalLock* self) {
     return NULL;
   }
   int result = 0;
+  ustimestamp_t wait_start = us_time();
 
   Py_BEGIN_ALLOW_THREADS;
   MUTEX_LOCK(self->mutex);
@@ -83,6 +130,11 @@ static PyObject* IntervalLock_lock(IntervalLock* self) {
   _Py_atomic_store_int32_relaxed(&self->locked, 1);
   self->owner = current_thread;
   self->lock_acquire_time = us_time();
+  self->acquisitions++;
+  int64_t waited = us_difftime(self->lock_acquire_time, wait_start);
+  if (waited > 0) {
+    self->total_wait_us += (uint64_t)waited;
+  }
 
   MUTEX_UNLOCK(self->mutex);
   Py_END_ALLOW_THREADS;
@@ -104,6 +156,14 @@ static PyObject* IntervalLock_unlock(IntervalLock* self) {
     _Py_atomic_store_int32_relaxed(&self->locked, 0);
     self->owner = 0;
     self->previous_owner = current_thread;
+    int64_t held = us_difftime(us_time(), self->lock_acquire_time);
+    if (held > 0) {
+      self->total_hold_us += (uint64_t)held;
+    }
+    self->releases++;
+    if (self->adaptive) {
+      IntervalLock_adapt(self);
+    }
     COND_SIGNAL(self->cond);
   }
 
@@ -118,6 +178,9 @@ static PyObject* IntervalLock_cede(IntervalLock* self) {
     return NULL;
   }
   Py_DECREF(result);
+  MUTEX_LOCK(self->mutex);
+  self->cedes++;
+  MUTEX_UNLOCK(self->mutex);
   return IntervalLock_lock(self);
 }
 
@@ -125,12 +188,48 @@ static PyObject* IntervalLock_poll(IntervalLock* self) {
   int64_t elapsed_time = us_difftime(us_time(), self->lock_acquire_time);
   /* Some form of clock reset event could make elapsed < 0 it which case we
      cede anyway as holding might be more dangerous than cedeing early. */
-  if (elapsed_time > (int64_t)self->interval || elapsed_time < 0) {
+  if (elapsed_time > (int64_t)self->current_interval || elapsed_time < 0) {
     return IntervalLock_cede(self);
   }
   Py_RETURN_NONE;
 }
 
+static PyObject* IntervalLock_stats(IntervalLock* self) {
+  uint64_t acquisitions;
+  uint64_t cedes;
+  uint64_t total_wait_us;
+  uint64_t total_hold_us;
+  uint64_t releases;
+  ustimestamp_t current_interval;
+
+  MUTEX_LOCK(self->mutex);
+  acquisitions = self->acquisitions;
+  cedes = self->cedes;
+  total_wait_us = self->total_wait_us;
+  total_hold_us = self->total_hold_us;
+  releases = self->releases;
+  current_interval = self->current_interval;
+  MUTEX_UNLOCK(self->mutex);
+
+  double average_wait =
+      acquisitions ? (double)total_wait_us / 1e6 / (double)acquisitions : 0.0;
+  double average_hold =
+      releases ? (double)total_hold_us / 1e6 / (double)releases : 0.0;
+
+  return Py_BuildValue(
+      "{s:K,s:K,s:d,s:d,s:d}",
+      "acquisitions",
+      (unsigned long long)acquisitions,
+      "cedes",
+      (unsigned long long)cedes,
+      "average_wait",
+      average_wait,
+      "average_hold",
+      average_hold,
+      "interval",
+      (double)current_interval / 1e6);
+}
+
 static PyObject* IntervalLock_enter(IntervalLock* self) {
   PyObject* result = IntervalLock_lock(self);
   if (!result) {
@@ -183,6 +282,11 @@ static PyMethodDef IntervalLock_methods[] = {
      (PyCFunction)IntervalLock_locked,
      METH_NOARGS,
      "Return the lock is locked or not."},
+    {"stats",
+     (PyCFunction)IntervalLock_stats,
+     METH_NOARGS,
+     "Return a dict of acquisitions, cedes, average_wait, average_hold and "
+     "the current effective interval."},
     {"__enter__",
      (PyCFunction)IntervalLock_enter,
      METH_NOARGS,
@@ -197,7 +301,10 @@ static PyMethodDef IntervalLock_methods[] = {
 static PyTypeObject IntervalLockType = {
     PyVarObject_HEAD_INIT(NULL, 0).tp_name = "IntervalLock",
     .tp_doc =
-        "IntervalLock(interval: float = 0.005): Creates an IntervalLock with the given interval in seconds.",
+        "IntervalLock(interval: float = 0.005, adaptive: bool = False): Creates an "
+        "IntervalLock with the given interval in seconds. With adaptive=True the "
+        "effective cede interval shrinks while threads are waiting and grows back "
+        "when uncontended.",
     .tp_basicsize = sizeof(IntervalLock),
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
@@ -215,16 +322,51 @@ static PyTypeObject IntervalLockType = {
  ****************
  */
 
+/* In the striped variant the reader count is sharded over this many cache
+   line padded slots indexed by a hash of the thread id, the classic
+   big-reader lock. Uncontended read acquisition is then an increment of a
+   (mostly) thread local line rather than every reader bouncing one counter
+   and the mutex between cores; writers pay by summing the stripes. */
+#define RW_NUM_STRIPES 8
+#define RW_STRIPE_STRIDE (64 / sizeof(int64_t))
+
 typedef struct {
   PyObject_HEAD MUTEX_TYPE rw_lock;
   COND_TYPE rw_condition;
   int32_t writers_waiting;
   int32_t writer_locked;
   int32_t readers;
+  int64_t* stripes; /* NULL unless constructed with striped=True. */
+  void* stripes_raw;
 } ReaderWriterLock;
 
+static inline int64_t* ReaderWriterLock_stripe(ReaderWriterLock* self) {
+  uintptr_t tid = (uintptr_t)THREAD_ID;
+  uintptr_t mixed = ((tid >> 4) ^ tid) * (uintptr_t)2654435761u;
+  return self->stripes +
+      (Py_ssize_t)(mixed % (uintptr_t)RW_NUM_STRIPES) * RW_STRIPE_STRIDE;
+}
+
+static inline int64_t ReaderWriterLock_reader_count(ReaderWriterLock* self) {
+  if (self->stripes == NULL) {
+    return _Py_atomic_load_int32_relaxed(&self->readers);
+  }
+  int64_t total = 0;
+  for (Py_ssize_t i = 0; i < RW_NUM_STRIPES; i++) {
+    total += _Py_atomic_load_int64(&self->stripes[i * RW_STRIPE_STRIDE]);
+  }
+  return total;
+}
+
 static PyObject*
 ReaderWriterLock_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = {"striped", NULL};
+  int striped = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &striped)) {
+    return NULL;
+  }
+
   ReaderWriterLock* self = (ReaderWriterLock*)type->tp_alloc(type, 0);
   if (self == NULL) {
     return NULL;
@@ -233,6 +375,22 @@ ReaderWriterLock_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
   self->readers = 0;
   self->writers_waiting = 0;
   self->writer_locked = 0;
+  self->stripes = NULL;
+  self->stripes_raw = NULL;
+
+  if (striped) {
+    /* Over-allocate so each stripe can sit on its own 64 byte line. */
+    self->stripes_raw =
+        PyMem_Calloc(RW_NUM_STRIPES * RW_STRIPE_STRIDE + RW_STRIPE_STRIDE,
+                     sizeof(int64_t));
+    if (self->stripes_raw == NULL) {
+      PyErr_NoMemory();
+      Py_DECREF(self);
+      return NULL;
+    }
+    self->stripes =
+        (int64_t*)(((uintptr_t)self->stripes_raw + 63) & ~(uintptr_t)63);
+  }
 
   if (MUTEX_INIT(self->rw_lock) || COND_INIT(self->rw_condition)) {
     PyErr_SetString(PyExc_RuntimeError, "Failed to initialize locks.");
@@ -246,12 +404,34 @@ ReaderWriterLock_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
 static void ReaderWriterLock_dealloc(ReaderWriterLock* self) {
   MUTEX_DESTROY(self->rw_lock);
   COND_DESTROY(self->rw_condition);
+  if (self->stripes_raw != NULL) {
+    PyMem_Free(self->stripes_raw);
+  }
   Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
 static PyObject* ReaderWriterLock_lock_read(ReaderWriterLock* self) {
+  if (self->stripes != NULL &&
+      !(_Py_atomic_load_int32(&self->writers_waiting) ||
+        _Py_atomic_load_int32(&self->writer_locked))) {
+    /* Announce ourselves on our stripe then double check no writer slipped
+       in; the seq_cst increment against the writer's seq_cst store of
+       writers_waiting means at least one side sees the other. */
+    _Py_atomic_add_int64(ReaderWriterLock_stripe(self), 1);
+    if (!(_Py_atomic_load_int32(&self->writers_waiting) ||
+          _Py_atomic_load_int32(&self->writer_locked))) {
+      Py_RETURN_NONE;
+    }
+    /* A writer raced us; back out and queue up on the mutex below. */
+    _Py_atomic_add_int64(ReaderWriterLock_stripe(self), -1);
+  }
   Py_BEGIN_ALLOW_THREADS;
   MUTEX_LOCK(self->rw_lock);
+  if (self->stripes != NULL) {
+    /* Our transient increment above may have put a writer to sleep on a
+       reader count which has since dropped; make it recheck. */
+    COND_BROADCAST(self->rw_condition);
+  }
   while (self->writers_waiting || self->writer_locked) {
     int result;
     if ((result = COND_WAIT(self->rw_condition, self->rw_lock))) {
@@ -265,13 +445,29 @@ static PyObject* ReaderWriterLock_lock_read(ReaderWriterLock* self) {
     }
   }
   /* Atomic for observer threads - see other atomics also. */
-  _Py_atomic_add_int32(&self->readers, 1);
+  if (self->stripes != NULL) {
+    _Py_atomic_add_int64(ReaderWriterLock_stripe(self), 1);
+  } else {
+    _Py_atomic_add_int32(&self->readers, 1);
+  }
   MUTEX_UNLOCK(self->rw_lock);
   Py_END_ALLOW_THREADS;
   Py_RETURN_NONE;
 }
 
 static PyObject* ReaderWriterLock_unlock_read(ReaderWriterLock* self) {
+  if (self->stripes != NULL) {
+    _Py_atomic_add_int64(ReaderWriterLock_stripe(self), -1);
+    /* Only fall back to the mutex when a writer may be waiting on us. */
+    if (_Py_atomic_load_int32(&self->writers_waiting)) {
+      Py_BEGIN_ALLOW_THREADS;
+      MUTEX_LOCK(self->rw_lock);
+      COND_BROADCAST(self->rw_condition);
+      MUTEX_UNLOCK(self->rw_lock);
+      Py_END_ALLOW_THREADS;
+    }
+    Py_RETURN_NONE;
+  }
   Py_BEGIN_ALLOW_THREADS;
   MUTEX_LOCK(self->rw_lock);
   atomic_int32_sub(&self->readers, 1);
@@ -285,7 +481,7 @@ static PyObject* ReaderWriterLock_lock_write(ReaderWriterLock* self) {
   Py_BEGIN_ALLOW_THREADS;
   MUTEX_LOCK(self->rw_lock);
   _Py_atomic_add_int32(&self->writers_waiting, 1);
-  while (self->readers > 0 || self->writer_locked) {
+  while (ReaderWriterLock_reader_count(self) > 0 || self->writer_locked) {
     int result;
     if ((result = COND_WAIT(self->rw_condition, self->rw_lock))) {
       atomic_int32_sub(&self->writers_waiting, 1);
@@ -300,8 +496,30 @@ static PyObject* ReaderWriterLock_lock_write(ReaderWriterLock* self) {
     }
   }
 
+  /* Publish writer_locked before dropping writers_waiting (both seq_cst)
+     so a striped reader's fast path can never observe both flags clear
+     while this writer is committed; at every instant at least one flag is
+     set, so any fast-path reader's recheck backs its stripe out again. */
+  _Py_atomic_store_int32(&self->writer_locked, 1);
   atomic_int32_sub(&self->writers_waiting, 1);
-  _Py_atomic_store_int32_relaxed(&self->writer_locked, 1);
+  /* A fast-path reader may have bumped its stripe between our last count
+     and the writer_locked publication. Its recheck is bound to see the
+     flag, back out and broadcast under the mutex, so waiting here cannot
+     hang; re-verify the count before claiming the lock. */
+  while (ReaderWriterLock_reader_count(self) > 0) {
+    int result;
+    if ((result = COND_WAIT(self->rw_condition, self->rw_lock))) {
+      _Py_atomic_store_int32(&self->writer_locked, 0);
+      COND_BROADCAST(self->rw_condition);
+      MUTEX_UNLOCK(self->rw_lock);
+      Py_BLOCK_THREADS;
+      PyErr_Format(
+          PyExc_RuntimeError,
+          "ReaderWriterLock wait failed with error %d",
+          result);
+      return NULL;
+    }
+  }
   MUTEX_UNLOCK(self->rw_lock);
   Py_END_ALLOW_THREADS;
   Py_RETURN_NONE;
@@ -318,7 +536,7 @@ static PyObject* ReaderWriterLock_unlock_write(ReaderWriterLock* self) {
 }
 
 static PyObject* ReaderWriterLock_readers(ReaderWriterLock* self) {
-  return PyLong_FromLong(_Py_atomic_load_int32_relaxed(&self->readers));
+  return PyLong_FromLongLong(ReaderWriterLock_reader_count(self));
 }
 
 static PyObject* ReaderWriterLock_writers_waiting(ReaderWriterLock* self) {
@@ -478,7 +696,9 @@ static PyMethodDef ReaderWriterLock_methods[] = {
 
 static PyTypeObject ReaderWriterLockType = {
     PyVarObject_HEAD_INIT(NULL, 0).tp_name = "synchronisation.RWLock",
-    .tp_doc = "Reader-Writer Lock",
+    .tp_doc =
+        "RWLock(striped: bool = False): Reader-Writer Lock. With striped=True "
+        "the reader count is sharded per thread for read-mostly scaling.",
     .tp_basicsize = sizeof(ReaderWriterLock),
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
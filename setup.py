@@ -42,9 +42,16 @@ def build_extensions() -> list[Extension]:
                 "native/src/_concurrency.c",
                 "native/src/ft_core.c",
                 "native/src/concurrent_data_structures/concurrent_dict.c",
+                "native/src/concurrent_data_structures/atomic_flag.c",
                 "native/src/concurrent_data_structures/atomic_int64.c",
+                "native/src/concurrent_data_structures/atomic_int64_array.c",
                 "native/src/concurrent_data_structures/atomic_reference.c",
+                "native/src/concurrent_data_structures/atomic_reference_array.c",
                 "native/src/concurrent_data_structures/concurrent_deque.c",
+                "native/src/concurrent_data_structures/concurrent_queue.c",
+                "native/src/concurrent_data_structures/concurrent_ring_queue.c",
+                "native/src/concurrent_data_structures/concurrent_set.c",
+                "native/src/concurrent_data_structures/shared_dict.c",
             ],
             include_dirs=include_dirs,
         ),
@@ -58,11 +65,31 @@ def build_extensions() -> list[Extension]:
             sources=["native/src/local.c"],
             include_dirs=include_dirs,
         ),
+        Extension(
+            "ft_utils._sort",
+            sources=["native/src/_sort.c"],
+            include_dirs=include_dirs,
+        ),
+        Extension(
+            "ft_utils.random",
+            sources=["native/src/random.c"],
+            include_dirs=include_dirs,
+        ),
+        Extension(
+            "ft_utils._timing",
+            sources=["native/src/_timing.c"],
+            include_dirs=include_dirs,
+        ),
         Extension(
             "ft_utils.synchronization",
             sources=["native/src/synchronization.c"],
             include_dirs=include_dirs,
         ),
+        Extension(
+            "ft_utils._test_capi",
+            sources=["ft_utils/tests/_test_capi.c"],
+            include_dirs=include_dirs,
+        ),
         Extension(
             "ft_utils._test_compat",
             sources=["ft_utils/tests/_test_compat.c"],